@@ -0,0 +1,307 @@
+#include "ConcurrentTaskManager.h"
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+
+ConcurrentTaskManager::Shard::Shard(int index, int count) : manager(index, count) {}
+
+ConcurrentTaskManager::ConcurrentTaskManager(int shardCount) {
+
+    if (shardCount < 1) {
+
+        throw std::invalid_argument("Error: A ConcurrentTaskManager needs at least one shard.");
+
+    }
+
+    for (int i = 0; i < shardCount; i++) {
+
+        shards.push_back(std::make_unique<Shard>(i, shardCount));
+
+    }
+}
+
+// Routing
+int ConcurrentTaskManager::shardCount() const {
+
+    return static_cast<int>(shards.size());
+}
+
+ConcurrentTaskManager::Shard &ConcurrentTaskManager::shardOfName(const string &personName) const {
+
+    return *shards[std::hash<string>()(personName) % shards.size()];
+}
+
+ConcurrentTaskManager::Shard &ConcurrentTaskManager::shardOfHandle(PersonHandle person) const {
+
+    if (person.id < 0) {
+
+        throw std::invalid_argument("Error: Invalid person handle.");
+
+    }
+
+    return *shards[person.id % shardCount()];
+}
+
+ConcurrentTaskManager::Shard &ConcurrentTaskManager::shardOfTask(int id) const {
+
+    return *shards[(id < 0 ? 0 : id) % shardCount()];
+}
+
+std::vector<std::unique_lock<std::shared_mutex>> ConcurrentTaskManager::lockAll() const {
+
+    // always in shard order, so two threads locking several shards cannot deadlock
+    std::vector<std::unique_lock<std::shared_mutex>> locks;
+
+    for (const std::unique_ptr<Shard> &shard : shards) {
+
+        locks.emplace_back(shard->lock);
+
+    }
+
+    return locks;
+}
+
+std::vector<std::shared_lock<std::shared_mutex>> ConcurrentTaskManager::lockAllShared() const {
+
+    std::vector<std::shared_lock<std::shared_mutex>> locks;
+
+    for (const std::unique_ptr<Shard> &shard : shards) {
+
+        locks.emplace_back(shard->lock);
+
+    }
+
+    return locks;
+}
+
+// Persons and tasks
+PersonHandle ConcurrentTaskManager::getPersonHandle(const string &personName) {
+
+    int index = static_cast<int>(std::hash<string>()(personName) % shards.size());
+
+    Shard &shard = *shards[index];
+
+    std::unique_lock<std::shared_mutex> guard(shard.lock);
+
+    // the handle keeps the shard in its low part, like task IDs do
+    return PersonHandle(shard.manager.getPersonHandle(personName).id * shardCount() + index);
+}
+
+int ConcurrentTaskManager::assignTask(const string &personName, const Task &task) {
+
+    Shard &shard = shardOfName(personName);
+
+    std::unique_lock<std::shared_mutex> guard(shard.lock);
+
+    return shard.manager.assignTask(personName, task);
+}
+
+int ConcurrentTaskManager::assignTask(PersonHandle person, const Task &task) {
+
+    Shard &shard = shardOfHandle(person);
+
+    std::unique_lock<std::shared_mutex> guard(shard.lock);
+
+    return shard.manager.assignTask(PersonHandle(person.id / shardCount()), task);
+}
+
+void ConcurrentTaskManager::completeTask(const string &personName) {
+
+    Shard &shard = shardOfName(personName);
+
+    std::unique_lock<std::shared_mutex> guard(shard.lock);
+
+    shard.manager.completeTask(personName);
+}
+
+void ConcurrentTaskManager::completeTask(PersonHandle person) {
+
+    Shard &shard = shardOfHandle(person);
+
+    std::unique_lock<std::shared_mutex> guard(shard.lock);
+
+    shard.manager.completeTask(PersonHandle(person.id / shardCount()));
+}
+
+void ConcurrentTaskManager::bumpPriorityByType(TaskType type, int priority) {
+
+    // O(1) per shard, so the shards are bumped one at a time instead of all locked together
+    for (const std::unique_ptr<Shard> &shard : shards) {
+
+        std::unique_lock<std::shared_mutex> guard(shard->lock);
+
+        shard->manager.bumpPriorityByType(type, priority);
+
+    }
+}
+
+std::optional<Task> ConcurrentTaskManager::findTask(int id) const {
+
+    Shard &shard = shardOfTask(id);
+
+    // finding applies pending bumps, so it needs the lock exclusively
+    std::unique_lock<std::shared_mutex> guard(shard.lock);
+
+    const Task *task = shard.manager.findTask(id);
+
+    if (task == nullptr) {
+
+        return std::nullopt;
+
+    }
+
+    return *task;
+}
+
+void ConcurrentTaskManager::cancelTask(int id) {
+
+    Shard &shard = shardOfTask(id);
+
+    std::unique_lock<std::shared_mutex> guard(shard.lock);
+
+    shard.manager.cancelTask(id);
+}
+
+void ConcurrentTaskManager::updatePriority(int id, int priority) {
+
+    Shard &shard = shardOfTask(id);
+
+    std::unique_lock<std::shared_mutex> guard(shard.lock);
+
+    shard.manager.updatePriority(id, priority);
+}
+
+// Queries
+int ConcurrentTaskManager::countAbove(int priority) const {
+
+    std::vector<std::shared_lock<std::shared_mutex>> locks = lockAllShared();
+
+    int count = 0;
+
+    for (const std::unique_ptr<Shard> &shard : shards) {
+
+        count += shard->manager.countAbove(priority);
+
+    }
+
+    return count;
+}
+
+int ConcurrentTaskManager::kthHighest(int k) const {
+
+    std::vector<std::shared_lock<std::shared_mutex>> locks = lockAllShared();
+
+    // the highest priority p that at least k tasks reach, found by binary search on the counts
+    int low = 0;
+
+    int high = 100;
+
+    int total = 0;
+
+    for (const std::unique_ptr<Shard> &shard : shards) {
+
+        total += shard->manager.countAbove(-1);
+
+    }
+
+    if (k < 1 || k > total) {
+
+        throw std::out_of_range("Error: No task of this rank.");
+
+    }
+
+    while (low < high) {
+
+        int middle = (low + high + 1) / 2;
+
+        int reaching = 0;
+
+        for (const std::unique_ptr<Shard> &shard : shards) {
+
+            reaching += shard->manager.countAbove(middle - 1);
+
+        }
+
+        if (reaching >= k) {
+
+            low = middle;
+
+        } else {
+
+            high = middle - 1;
+
+        }
+    }
+
+    return low;
+}
+
+void ConcurrentTaskManager::printAllEmployees(OutputSink &sink) const {
+
+    std::vector<std::unique_lock<std::shared_mutex>> locks = lockAll();
+
+    TaskWriter writer(sink);
+
+    for (const std::unique_ptr<Shard> &shard : shards) {
+
+        shard->manager.visitEmployees([&writer](const Person &person) {
+
+            writer.writePerson(person);
+
+            writer.write('\n');
+
+        });
+    }
+
+    writer.flush();
+}
+
+void ConcurrentTaskManager::printAllTasks(OutputSink &sink) const {
+
+    std::vector<std::unique_lock<std::shared_mutex>> locks = lockAll();
+
+    TaskManager::TaskRange allTasks;
+
+    for (const std::unique_ptr<Shard> &shard : shards) {
+
+        allTasks.add(shard->manager.tasks());
+
+    }
+
+    TaskWriter writer(sink);
+
+    for (const Task &task : allTasks) {
+
+        writer.writeTask(task);
+
+        writer.write('\n');
+
+    }
+
+    writer.flush();
+}
+
+void ConcurrentTaskManager::printTasksByType(TaskType type, OutputSink &sink) const {
+
+    std::vector<std::unique_lock<std::shared_mutex>> locks = lockAll();
+
+    TaskManager::TaskRange ofType;
+
+    for (const std::unique_ptr<Shard> &shard : shards) {
+
+        ofType.add(shard->manager.tasksByType(type));
+
+    }
+
+    TaskWriter writer(sink);
+
+    for (const Task &task : ofType) {
+
+        writer.writeTask(task);
+
+        writer.write('\n');
+
+    }
+
+    writer.flush();
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+#include "TaskManager.h"
+
+/**
+ * @brief Thread-safe task manager that spreads persons over independently locked shards.
+ *
+ * Every person lives in the shard picked by the hash of the person's name, and every shard is a
+ * TaskManager of its own behind its own reader/writer lock, on its own cache lines. Operations on
+ * one person lock only that person's shard, so threads working on different people rarely wait
+ * for each other. Shard s hands out the task IDs s, s + n, s + 2n, ... for n shards, so no ID
+ * counter is shared either; IDs are unique, but across shards they do not follow assignment order.
+ *
+ * Operations that span shards lock them one after the other in shard order. The counting queries
+ * take the locks shared; the others change lazily applied state and take them exclusively.
+ */
+class ConcurrentTaskManager {
+private:
+    struct alignas(64) Shard {
+        std::shared_mutex lock;
+        TaskManager manager;
+
+        Shard(int index, int count);
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    int shardCount() const;
+    Shard &shardOfName(const string &personName) const;
+    Shard &shardOfHandle(PersonHandle person) const;
+    Shard &shardOfTask(int id) const;
+    std::vector<std::unique_lock<std::shared_mutex>> lockAll() const;
+    std::vector<std::shared_lock<std::shared_mutex>> lockAllShared() const;
+
+public:
+    /**
+     * @brief Constructor to create an empty ConcurrentTaskManager.
+     *
+     * @param shardCount The number of shards, at least 1.
+     */
+    explicit ConcurrentTaskManager(int shardCount = 16);
+
+    ConcurrentTaskManager(const ConcurrentTaskManager &other) = delete;
+    ConcurrentTaskManager &operator=(const ConcurrentTaskManager &other) = delete;
+
+    /**
+     * @brief Gets the handle of a person, adding the person (with no tasks) if needed.
+     *
+     * @param personName The name of the person.
+     * @return PersonHandle A handle that stays valid for the lifetime of this manager.
+     */
+    PersonHandle getPersonHandle(const string &personName);
+
+    /**
+     * @brief Assigns a task to a person.
+     *
+     * @param personName The name of the person to whom the task will be assigned.
+     * @param task The task to be assigned.
+     * @return int The ID given to the task.
+     */
+    int assignTask(const string &personName, const Task &task);
+
+    /**
+     * @brief Assigns a task to a person identified by a handle.
+     *
+     * @param person The handle of the person to whom the task will be assigned.
+     * @param task The task to be assigned.
+     * @return int The ID given to the task.
+     * @throws std::invalid_argument If the handle is out of range for this manager.
+     */
+    int assignTask(PersonHandle person, const Task &task);
+
+    /**
+     * @brief Completes the highest priority task assigned to a person.
+     *
+     * @param personName The name of the person who will complete the task.
+     */
+    void completeTask(const string &personName);
+
+    /**
+     * @brief Completes the highest priority task assigned to a person identified by a handle.
+     *
+     * @param person The handle of the person who will complete the task.
+     * @throws std::invalid_argument If the handle is out of range for this manager.
+     */
+    void completeTask(PersonHandle person);
+
+    /**
+     * @brief Bumps the priority of all tasks of a specific type, shard by shard.
+     *
+     * @param type The type of tasks whose priority will be bumped.
+     * @param priority The amount by which the priority will be increased.
+     */
+    void bumpPriorityByType(TaskType type, int priority);
+
+    /**
+     * @brief Finds a task by its ID.
+     *
+     * @param id The ID of the task.
+     * @return std::optional<Task> A copy of the task, or nothing if no task with this ID is assigned.
+     */
+    std::optional<Task> findTask(int id) const;
+
+    /**
+     * @brief Removes a task, found by its ID.
+     *
+     * @param id The ID of the task.
+     * @throws std::invalid_argument If no task with this ID is assigned.
+     */
+    void cancelTask(int id);
+
+    /**
+     * @brief Changes the priority of a task, found by its ID.
+     *
+     * @param id The ID of the task.
+     * @param priority The new priority, enforced to be in range [0, 100].
+     * @throws std::invalid_argument If no task with this ID is assigned.
+     */
+    void updatePriority(int id, int priority);
+
+    /**
+     * @brief Counts the tasks with a priority higher than the given one.
+     */
+    int countAbove(int priority) const;
+
+    /**
+     * @brief Gets the priority of the k-th highest priority task.
+     *
+     * @param k The rank of the task, starting from 1.
+     * @return int The priority of the task.
+     * @throws std::out_of_range If there are fewer than k tasks or k is not positive.
+     */
+    int kthHighest(int k) const;
+
+    /**
+     * @brief Prints all employees and their tasks, shard by shard.
+     *
+     * @param sink The sink receiving the text.
+     */
+    void printAllEmployees(OutputSink &sink) const;
+
+    /**
+     * @brief Prints all tasks assigned to all employees, from highest to lowest priority.
+     *
+     * @param sink The sink receiving the text.
+     */
+    void printAllTasks(OutputSink &sink) const;
+
+    /**
+     * @brief Prints all tasks of a specific type, from highest to lowest priority.
+     *
+     * @param type The type of tasks to be printed.
+     * @param sink The sink receiving the text.
+     */
+    void printTasksByType(TaskType type, OutputSink &sink) const;
+};
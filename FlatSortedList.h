@@ -0,0 +1,329 @@
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "SortedList.h"
+
+namespace mtm {
+
+    /**
+     * @brief Sorted list stored in one contiguous vector.
+     *
+     * Offers the same surface and the same iteration order as SortedList (highest element first,
+     * a new element goes before the elements equal to it), but keeps the elements next to each
+     * other in memory. The vector holds them in ascending order so that the first element sits at
+     * the back, which makes front() and pop_front() O(1). Insertion finds its position with a
+     * binary search and then shifts the tail, so it is O(n); iteration is a linear scan.
+     *
+     * Meant for read-heavy lists that change rarely.
+     */
+    template <typename T>
+    class FlatSortedList {
+    private:
+        std::vector<T> items;
+
+        int insertPosition(const T& data) const;
+
+    public:
+        class ConstIterator;
+
+        FlatSortedList() = default;
+        template <typename InputIterator>
+        FlatSortedList(InputIterator first, InputIterator last);
+        template <typename InputIterator>
+        FlatSortedList(AlreadySorted, InputIterator first, InputIterator last);
+
+        ConstIterator begin() const;
+        ConstIterator end() const;
+        ConstIterator insert(const T& data);
+        ConstIterator insert(T&& data);
+        template <typename... Args>
+        void emplace(Args&&... args);
+        void remove(const ConstIterator& it);
+        template<typename Operation>
+        void modify(const ConstIterator& it, Operation op);
+        ConstIterator find(const T& key) const;
+
+        /**
+         * @brief Always nullptr: elements move whenever the vector changes, so none has a stable handle.
+         */
+        const void* handle(const ConstIterator& it) const;
+
+        /**
+         * @brief Never finds an element, as no handle is ever given out; use find instead.
+         */
+        ConstIterator at(const void* handle) const;
+        const T& front() const;
+        void pop_front();
+        const T& back() const;
+        void pop_back();
+        int length() const;
+        ListView<FlatSortedList> view() const;
+        template<typename Predicate>
+        FlatSortedList filter(Predicate predicate) const;
+        template<typename Operation>
+        FlatSortedList apply(Operation op) const;
+        template<typename Operation>
+        void transform(Operation op);
+    };
+
+    template <typename T>
+    class FlatSortedList<T>::ConstIterator {
+        const FlatSortedList* list;
+        // index into the ascending vector, -1 is the end
+        int index;
+        ConstIterator(const FlatSortedList* list, int index);
+        friend class FlatSortedList;
+
+    public:
+        ConstIterator(const ConstIterator& other) = default;
+        ConstIterator& operator=(const ConstIterator& other) = default;
+        ~ConstIterator() = default;
+
+        const T& operator*() const;
+        ConstIterator& operator++();
+        bool operator!=(const ConstIterator& other) const;
+    };
+
+    template <typename T>
+    int FlatSortedList<T>::insertPosition(const T& data) const {
+        // The new element goes after every element that is not greater than it
+        int low = 0;
+        int high = static_cast<int>(items.size());
+        if constexpr (std::is_arithmetic<T>::value) {
+            // Narrow down with a binary search, then count the rest of the window without
+            // branches so the compiler can vectorize the comparison
+            const int WINDOW = 32;
+            while (high - low > WINDOW) {
+                int middle = low + (high - low) / 2;
+                if (items[middle] > data) {
+                    high = middle;
+                } else {
+                    low = middle + 1;
+                }
+            }
+            const T* window = items.data() + low;
+            int count = 0;
+            for (int i = 0; i < high - low; ++i) {
+                count += !(window[i] > data);
+            }
+            return low + count;
+        } else {
+            while (low < high) {
+                int middle = low + (high - low) / 2;
+                if (items[middle] > data) {
+                    high = middle;
+                } else {
+                    low = middle + 1;
+                }
+            }
+            return low;
+        }
+    }
+
+    template <typename T>
+    template <typename InputIterator>
+    FlatSortedList<T>::FlatSortedList(InputIterator first, InputIterator last) {
+        for (; first != last; ++first) {
+            items.push_back(*first);
+        }
+        // ascending storage; reversing first keeps equal elements in range order when iterating
+        std::reverse(items.begin(), items.end());
+        auto less = [](const T& lhs, const T& rhs) { return rhs > lhs; };
+        if (!std::is_sorted(items.begin(), items.end(), less)) {
+            std::stable_sort(items.begin(), items.end(), less);
+        }
+    }
+
+    template <typename T>
+    template <typename InputIterator>
+    FlatSortedList<T>::FlatSortedList(AlreadySorted, InputIterator first, InputIterator last) {
+        for (; first != last; ++first) {
+            items.push_back(*first);
+        }
+        std::reverse(items.begin(), items.end());
+    }
+
+    template <typename T>
+    typename FlatSortedList<T>::ConstIterator FlatSortedList<T>::begin() const {
+        return ConstIterator(this, static_cast<int>(items.size()) - 1);
+    }
+
+    template <typename T>
+    typename FlatSortedList<T>::ConstIterator FlatSortedList<T>::end() const {
+        return ConstIterator(this, -1);
+    }
+
+    template <typename T>
+    typename FlatSortedList<T>::ConstIterator FlatSortedList<T>::insert(const T& data) {
+        int position = insertPosition(data);
+        items.insert(items.begin() + position, data);
+        return ConstIterator(this, position);
+    }
+
+    template <typename T>
+    typename FlatSortedList<T>::ConstIterator FlatSortedList<T>::insert(T&& data) {
+        int position = insertPosition(data);
+        items.insert(items.begin() + position, std::move(data));
+        return ConstIterator(this, position);
+    }
+
+    template <typename T>
+    template <typename... Args>
+    void FlatSortedList<T>::emplace(Args&&... args) {
+        insert(T(std::forward<Args>(args)...));
+    }
+
+    template <typename T>
+    void FlatSortedList<T>::remove(const ConstIterator& it) {
+        if (it.index < 0) {
+            return;
+        }
+        if (it.list != this || it.index >= static_cast<int>(items.size())) {
+            throw std::invalid_argument("Iterator does not point to a valid element");
+        }
+        items.erase(items.begin() + it.index);
+    }
+
+    template <typename T>
+    template <typename Operation>
+    void FlatSortedList<T>::modify(const ConstIterator& it, Operation op) {
+        if (it.list != this || it.index < 0 || it.index >= static_cast<int>(items.size())) {
+            throw std::invalid_argument("Iterator does not point to a valid element");
+        }
+        T item = std::move(items[it.index]);
+        items.erase(items.begin() + it.index);
+        try {
+            op(item);
+        } catch (...) {
+            insert(std::move(item));
+            throw;
+        }
+        insert(std::move(item));
+    }
+
+    template <typename T>
+    typename FlatSortedList<T>::ConstIterator FlatSortedList<T>::find(const T& key) const {
+        // binary search for the lowest element that is not lower than key
+        int low = 0;
+        int high = static_cast<int>(items.size());
+        while (low < high) {
+            int middle = low + (high - low) / 2;
+            if (key > items[middle]) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        if (low < static_cast<int>(items.size()) && !(items[low] > key)) {
+            return ConstIterator(this, low);
+        }
+        return end();
+    }
+
+    template <typename T>
+    const void* FlatSortedList<T>::handle(const ConstIterator&) const {
+        return nullptr;
+    }
+
+    template <typename T>
+    typename FlatSortedList<T>::ConstIterator FlatSortedList<T>::at(const void*) const {
+        return end();
+    }
+
+    template <typename T>
+    const T& FlatSortedList<T>::front() const {
+        if (items.empty()) {
+            throw std::out_of_range("Accessing the front of an empty list");
+        }
+        return items.back();
+    }
+
+    template <typename T>
+    void FlatSortedList<T>::pop_front() {
+        if (items.empty()) {
+            throw std::out_of_range("Removing from an empty list");
+        }
+        items.pop_back();
+    }
+
+    template <typename T>
+    const T& FlatSortedList<T>::back() const {
+        if (items.empty()) {
+            throw std::out_of_range("Accessing the back of an empty list");
+        }
+        return items.front();
+    }
+
+    template <typename T>
+    void FlatSortedList<T>::pop_back() {
+        if (items.empty()) {
+            throw std::out_of_range("Removing from an empty list");
+        }
+        // the last element sits at the front of the vector, so this shifts the rest
+        items.erase(items.begin());
+    }
+
+    template <typename T>
+    int FlatSortedList<T>::length() const {
+        return static_cast<int>(items.size());
+    }
+
+    template <typename T>
+    ListView<FlatSortedList<T>> FlatSortedList<T>::view() const {
+        return ListView<FlatSortedList>(*this);
+    }
+
+    template <typename T>
+    template <typename Predicate>
+    FlatSortedList<T> FlatSortedList<T>::filter(Predicate predicate) const {
+        return view().filter(predicate).template materialize<FlatSortedList>();
+    }
+
+    template <typename T>
+    template <typename Operation>
+    FlatSortedList<T> FlatSortedList<T>::apply(Operation op) const {
+        return view().apply(op).template materialize<FlatSortedList>();
+    }
+
+    template <typename T>
+    template <typename Operation>
+    void FlatSortedList<T>::transform(Operation op) {
+        for (T& item : items) {
+            op(item);
+        }
+        auto less = [](const T& lhs, const T& rhs) { return rhs > lhs; };
+        if (!std::is_sorted(items.begin(), items.end(), less)) {
+            std::stable_sort(items.begin(), items.end(), less);
+        }
+    }
+
+    template <typename T>
+    FlatSortedList<T>::ConstIterator::ConstIterator(const FlatSortedList* list, int index) : list(list), index(index) {}
+
+    template <typename T>
+    const T& FlatSortedList<T>::ConstIterator::operator*() const {
+        if (index < 0) {
+            throw std::range_error("Dereferencing end iterator");
+        }
+        return list->items[index];
+    }
+
+    template <typename T>
+    typename FlatSortedList<T>::ConstIterator& FlatSortedList<T>::ConstIterator::operator++() {
+        if (index < 0) {
+            throw std::out_of_range("Incrementing end iterator");
+        }
+        index--;
+        return *this;
+    }
+
+    template <typename T>
+    bool FlatSortedList<T>::ConstIterator::operator!=(const ConstIterator& other) const {
+        return index != other.index || list != other.list;
+    }
+
+}
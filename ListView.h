@@ -0,0 +1,254 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+#include "SortedList.h"
+
+namespace mtm {
+
+    template <typename Source, typename Predicate>
+    class FilterView;
+
+    template <typename Source, typename Operation>
+    class ApplyView;
+
+    template <typename Source>
+    class TakeView;
+
+    template <typename List, typename View>
+    struct MaterializedList {
+        typedef List type;
+    };
+
+    // by default a view materializes into a SortedList of its element type
+    template <typename View>
+    struct MaterializedList<void, View> {
+        typedef SortedList<typename std::decay<decltype(*std::declval<typename View::Iterator>())>::type> type;
+    };
+
+    /**
+     * @brief Operations shared by every lazy view over a SortedList.
+     *
+     * Views only remember how to produce their elements; nothing is copied or evaluated until
+     * the view is iterated or materialized. Every view is cheap to copy and can be chained:
+     * list.view().filter(isUrgent).apply(toSummary).take(10).
+     *
+     * A view refers to the list it was created from and must not outlive it.
+     */
+    template <typename Derived>
+    class ViewBase {
+    private:
+        const Derived& self() const {
+            return static_cast<const Derived&>(*this);
+        }
+
+    public:
+        /**
+         * @brief Keeps only the elements for which predicate returns true.
+         */
+        template <typename Predicate>
+        FilterView<Derived, Predicate> filter(Predicate predicate) const {
+            return FilterView<Derived, Predicate>(self(), predicate);
+        }
+
+        /**
+         * @brief Replaces every element by the result of op. The result may no longer be sorted.
+         */
+        template <typename Operation>
+        ApplyView<Derived, Operation> apply(Operation op) const {
+            return ApplyView<Derived, Operation>(self(), op);
+        }
+
+        /**
+         * @brief Stops after the first count elements.
+         */
+        TakeView<Derived> take(int count) const {
+            return TakeView<Derived>(self(), count);
+        }
+
+        /**
+         * @brief Evaluates the view into a real list.
+         *
+         * Views that kept the source order are appended in order; views that went through
+         * apply() are sorted once.
+         *
+         * @tparam List The list type to build, SortedList of the element type by default.
+         */
+        template <typename List = void, typename View = Derived>
+        typename MaterializedList<List, View>::type materialize() const {
+            typedef typename MaterializedList<List, View>::type Result;
+            if constexpr (View::ORDERED) {
+                return Result(AlreadySorted(), self().begin(), self().end());
+            } else {
+                return Result(self().begin(), self().end());
+            }
+        }
+    };
+
+    /**
+     * @brief View over all the elements of a SortedList, in order.
+     */
+    template <typename List>
+    class ListView : public ViewBase<ListView<List>> {
+    private:
+        const List* list;
+
+    public:
+        typedef typename List::ConstIterator Iterator;
+        static const bool ORDERED = true;
+
+        explicit ListView(const List& list) : list(&list) {}
+
+        Iterator begin() const {
+            return list->begin();
+        }
+
+        Iterator end() const {
+            return list->end();
+        }
+    };
+
+    template <typename Source, typename Predicate>
+    class FilterView : public ViewBase<FilterView<Source, Predicate>> {
+    private:
+        Source source;
+        Predicate predicate;
+
+    public:
+        class Iterator {
+            typename Source::Iterator current;
+            typename Source::Iterator last;
+            const Predicate* predicate;
+
+            void skip() {
+                while (current != last && !(*predicate)(*current)) {
+                    ++current;
+                }
+            }
+
+        public:
+            Iterator(typename Source::Iterator current, typename Source::Iterator last, const Predicate* predicate)
+                : current(current), last(last), predicate(predicate) {
+                skip();
+            }
+
+            decltype(*std::declval<typename Source::Iterator>()) operator*() const {
+                return *current;
+            }
+
+            Iterator& operator++() {
+                ++current;
+                skip();
+                return *this;
+            }
+
+            bool operator!=(const Iterator& other) const {
+                return current != other.current;
+            }
+        };
+
+        static const bool ORDERED = Source::ORDERED;
+
+        FilterView(const Source& source, Predicate predicate) : source(source), predicate(predicate) {}
+
+        Iterator begin() const {
+            return Iterator(source.begin(), source.end(), &predicate);
+        }
+
+        Iterator end() const {
+            return Iterator(source.end(), source.end(), &predicate);
+        }
+    };
+
+    template <typename Source, typename Operation>
+    class ApplyView : public ViewBase<ApplyView<Source, Operation>> {
+    private:
+        Source source;
+        Operation op;
+
+    public:
+        class Iterator {
+            typename Source::Iterator current;
+            const Operation* op;
+
+        public:
+            Iterator(typename Source::Iterator current, const Operation* op) : current(current), op(op) {}
+
+            decltype(std::declval<const Operation&>()(*std::declval<typename Source::Iterator>())) operator*() const {
+                return (*op)(*current);
+            }
+
+            Iterator& operator++() {
+                ++current;
+                return *this;
+            }
+
+            bool operator!=(const Iterator& other) const {
+                return current != other.current;
+            }
+        };
+
+        static const bool ORDERED = false;
+
+        ApplyView(const Source& source, Operation op) : source(source), op(op) {}
+
+        Iterator begin() const {
+            return Iterator(source.begin(), &op);
+        }
+
+        Iterator end() const {
+            return Iterator(source.end(), &op);
+        }
+    };
+
+    template <typename Source>
+    class TakeView : public ViewBase<TakeView<Source>> {
+    private:
+        Source source;
+        int count;
+
+    public:
+        class Iterator {
+            typename Source::Iterator current;
+            typename Source::Iterator last;
+            int remaining;
+
+        public:
+            Iterator(typename Source::Iterator current, typename Source::Iterator last, int remaining)
+                : current(current), last(last), remaining(remaining) {}
+
+            decltype(*std::declval<typename Source::Iterator>()) operator*() const {
+                return *current;
+            }
+
+            Iterator& operator++() {
+                ++current;
+                remaining--;
+                return *this;
+            }
+
+            bool operator!=(const Iterator& other) const {
+                // an exhausted count compares equal to the end iterator
+                bool done = remaining <= 0 || !(current != last);
+                bool otherDone = other.remaining <= 0 || !(other.current != other.last);
+                if (done || otherDone) {
+                    return done != otherDone;
+                }
+                return current != other.current;
+            }
+        };
+
+        static const bool ORDERED = Source::ORDERED;
+
+        TakeView(const Source& source, int count) : source(source), count(count) {}
+
+        Iterator begin() const {
+            return Iterator(source.begin(), source.end(), count);
+        }
+
+        Iterator end() const {
+            return Iterator(source.end(), source.end(), 0);
+        }
+    };
+
+}
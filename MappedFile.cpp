@@ -0,0 +1,66 @@
+#include "MappedFile.h"
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mtm {
+
+    MappedFile::MappedFile(const std::string& path) : m_data(nullptr), m_size(0), m_mapped(false) {
+#if defined(__unix__) || defined(__APPLE__)
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Error: Cannot open " + path + ".");
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Error: Cannot read the size of " + path + ".");
+        }
+        m_size = static_cast<std::size_t>(info.st_size);
+        // an empty file cannot be mapped, and there is nothing to map anyway
+        if (m_size > 0) {
+            void* mapping = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Error: Cannot map " + path + ".");
+            }
+            ::madvise(mapping, m_size, MADV_SEQUENTIAL);
+            m_data = static_cast<const char*>(mapping);
+            m_mapped = true;
+        }
+        // the mapping keeps the file alive on its own
+        ::close(fd);
+#else
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("Error: Cannot open " + path + ".");
+        }
+        m_copy.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        m_data = m_copy.data();
+        m_size = m_copy.size();
+#endif
+    }
+
+    MappedFile::~MappedFile() {
+#if defined(__unix__) || defined(__APPLE__)
+        if (m_mapped) {
+            ::munmap(const_cast<char*>(m_data), m_size);
+        }
+#endif
+    }
+
+    const char* MappedFile::data() const {
+        return m_data;
+    }
+
+    std::size_t MappedFile::size() const {
+        return m_size;
+    }
+
+}
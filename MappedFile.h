@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace mtm {
+
+    /**
+     * @brief Read-only view of a whole file.
+     *
+     * The file is memory-mapped where the platform supports it, so opening it costs no copy and
+     * pages are read in as they are first touched; elsewhere it is read into memory at once.
+     */
+    class MappedFile {
+    private:
+        const char* m_data;
+        std::size_t m_size;
+        bool m_mapped;
+        std::vector<char> m_copy;
+
+    public:
+        /**
+         * @brief Constructor to map a file.
+         *
+         * @param path The path of the file.
+         * @throws std::runtime_error If the file cannot be opened or mapped.
+         */
+        explicit MappedFile(const std::string& path);
+        MappedFile(const MappedFile& other) = delete;
+        MappedFile& operator=(const MappedFile& other) = delete;
+        ~MappedFile();
+
+        const char* data() const;
+        std::size_t size() const;
+    };
+
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace mtm {
+
+    /**
+     * @brief Iterates over several sorted ranges as one sorted sequence, without copying them.
+     *
+     * Every range must be ordered from the highest element to the lowest, like a SortedList. The
+     * iterator keeps a binary heap with one cursor per non-empty range, so producing each element
+     * costs O(log k) for k ranges and a whole pass over N elements costs O(N log k). Elements are
+     * returned by reference into the ranges, which must stay unchanged while iterating.
+     */
+    template <typename Iterator>
+    class MergeIterator {
+    public:
+        typedef std::pair<Iterator, Iterator> Range;
+        typedef decltype(*std::declval<const Iterator&>()) Reference;
+
+    private:
+        // cursors of the ranges that are not exhausted, as a heap with the greatest element on top
+        std::vector<Range> heap;
+
+        static bool lower(const Range& lhs, const Range& rhs);
+
+    public:
+        /**
+         * @brief Creates the end iterator.
+         */
+        MergeIterator() = default;
+
+        /**
+         * @brief Creates an iterator at the greatest element of the given ranges.
+         *
+         * @param ranges Pairs of (begin, end) iterators, each range sorted from highest to lowest.
+         */
+        explicit MergeIterator(std::vector<Range> ranges);
+
+        Reference operator*() const;
+        MergeIterator& operator++();
+        bool operator!=(const MergeIterator& other) const;
+    };
+
+    /**
+     * @brief The merge of several sorted ranges, for range-based for loops.
+     */
+    template <typename Iterator>
+    class MergeRange {
+        std::vector<typename MergeIterator<Iterator>::Range> ranges;
+
+    public:
+        /**
+         * @brief Adds a range to merge.
+         *
+         * @param first The beginning of the range.
+         * @param last The end of the range.
+         */
+        void add(Iterator first, Iterator last);
+
+        /**
+         * @brief Adds all the ranges of another merge.
+         *
+         * @param other The merge whose ranges are added.
+         */
+        void add(const MergeRange& other);
+
+        MergeIterator<Iterator> begin() const;
+        MergeIterator<Iterator> end() const;
+    };
+
+    template <typename Iterator>
+    bool MergeIterator<Iterator>::lower(const Range& lhs, const Range& rhs) {
+        return *rhs.first > *lhs.first;
+    }
+
+    template <typename Iterator>
+    MergeIterator<Iterator>::MergeIterator(std::vector<Range> ranges) {
+        for (Range& range : ranges) {
+            if (range.first != range.second) {
+                heap.push_back(std::move(range));
+            }
+        }
+        std::make_heap(heap.begin(), heap.end(), lower);
+    }
+
+    template <typename Iterator>
+    typename MergeIterator<Iterator>::Reference MergeIterator<Iterator>::operator*() const {
+        if (heap.empty()) {
+            throw std::range_error("Dereferencing end iterator");
+        }
+        return *heap.front().first;
+    }
+
+    template <typename Iterator>
+    MergeIterator<Iterator>& MergeIterator<Iterator>::operator++() {
+        if (heap.empty()) {
+            throw std::out_of_range("Incrementing end iterator");
+        }
+        std::pop_heap(heap.begin(), heap.end(), lower);
+        Range& top = heap.back();
+        ++top.first;
+        if (top.first != top.second) {
+            std::push_heap(heap.begin(), heap.end(), lower);
+        } else {
+            heap.pop_back();
+        }
+        return *this;
+    }
+
+    template <typename Iterator>
+    bool MergeIterator<Iterator>::operator!=(const MergeIterator& other) const {
+        if (heap.size() != other.heap.size()) {
+            return true;
+        }
+        return !heap.empty() && heap.front().first != other.heap.front().first;
+    }
+
+    template <typename Iterator>
+    void MergeRange<Iterator>::add(Iterator first, Iterator last) {
+        if (first != last) {
+            ranges.emplace_back(first, last);
+        }
+    }
+
+    template <typename Iterator>
+    void MergeRange<Iterator>::add(const MergeRange& other) {
+        ranges.insert(ranges.end(), other.ranges.begin(), other.ranges.end());
+    }
+
+    template <typename Iterator>
+    MergeIterator<Iterator> MergeRange<Iterator>::begin() const {
+        return MergeIterator<Iterator>(ranges);
+    }
+
+    template <typename Iterator>
+    MergeIterator<Iterator> MergeRange<Iterator>::end() const {
+        return MergeIterator<Iterator>();
+    }
+
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace mtm {
+
+    /**
+     * @brief Bounded lock-free queue for any number of producer and consumer threads.
+     *
+     * A ring of cells, each stamped with a sequence number telling whether it is free for the
+     * producer of a given position or full for its consumer. A producer claims a position with one
+     * compare-and-swap on the enqueue counter and publishes its element with one store to the
+     * cell's stamp, and consumers work the same way on the dequeue counter, so neither side ever
+     * waits for a lock or for a thread that was descheduled mid-operation on another cell. The two
+     * counters live on separate cache lines.
+     *
+     * @tparam T The type of the elements. Moving it should not throw.
+     */
+    template <typename T>
+    class MpmcQueue {
+    private:
+        static const std::size_t CACHE_LINE = 64;
+
+        struct Cell {
+            std::atomic<std::size_t> sequence;
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+
+        std::unique_ptr<Cell[]> cells;
+        std::size_t mask;
+        alignas(CACHE_LINE) std::atomic<std::size_t> enqueuePosition;
+        alignas(CACHE_LINE) std::atomic<std::size_t> dequeuePosition;
+
+        static std::size_t roundUp(std::size_t capacity) {
+            std::size_t size = 2;
+            while (size < capacity) {
+                size *= 2;
+            }
+            return size;
+        }
+
+    public:
+        /**
+         * @brief Constructor to create an empty queue.
+         *
+         * @param capacity The minimal number of elements the queue holds, rounded up to a power of two.
+         */
+        explicit MpmcQueue(std::size_t capacity)
+            : cells(new Cell[roundUp(capacity)]), mask(roundUp(capacity) - 1), enqueuePosition(0),
+              dequeuePosition(0) {
+            for (std::size_t i = 0; i <= mask; i++) {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MpmcQueue(const MpmcQueue& other) = delete;
+        MpmcQueue& operator=(const MpmcQueue& other) = delete;
+
+        ~MpmcQueue() {
+            T item;
+            while (tryPop(item)) {
+            }
+        }
+
+        /**
+         * @brief Gets the number of elements the queue holds when full.
+         */
+        std::size_t capacity() const {
+            return mask + 1;
+        }
+
+        /**
+         * @brief Adds an element at the back of the queue, unless the queue is full.
+         *
+         * @param value The element, moved from only if it is added.
+         * @return bool Whether the element was added.
+         */
+        bool tryPush(T&& value) {
+            std::size_t position = enqueuePosition.load(std::memory_order_relaxed);
+            Cell* cell;
+            while (true) {
+                cell = &cells[position & mask];
+                std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                std::intptr_t difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+                if (difference == 0) {
+                    if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (difference < 0) {
+                    return false;
+                } else {
+                    position = enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+            new (cell->storage) T(std::move(value));
+            cell->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Removes the element at the front of the queue, unless the queue is empty.
+         *
+         * @param out Receives the element.
+         * @return bool Whether an element was removed.
+         */
+        bool tryPop(T& out) {
+            std::size_t position = dequeuePosition.load(std::memory_order_relaxed);
+            Cell* cell;
+            while (true) {
+                cell = &cells[position & mask];
+                std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                std::intptr_t difference =
+                    static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+                if (difference == 0) {
+                    if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (difference < 0) {
+                    return false;
+                } else {
+                    position = dequeuePosition.load(std::memory_order_relaxed);
+                }
+            }
+            T* item = std::launder(reinterpret_cast<T*>(cell->storage));
+            out = std::move(*item);
+            item->~T();
+            cell->sequence.store(position + mask + 1, std::memory_order_release);
+            return true;
+        }
+    };
+
+}
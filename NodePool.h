@@ -0,0 +1,178 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace mtm {
+
+    /**
+     * @brief Node allocator that takes every node straight from the global heap.
+     */
+    struct HeapAllocator {
+        template <typename Node>
+        static void* allocate() {
+            return ::operator new(sizeof(Node));
+        }
+
+        template <typename Node>
+        static void deallocate(void* block) {
+            ::operator delete(block);
+        }
+    };
+
+    /**
+     * @brief Free list of fixed-size blocks carved out of large slabs.
+     *
+     * Each thread owns its own free list, so allocation and deallocation rarely lock. Slabs are
+     * only ever handed out, never returned to the heap. A block freed on another thread joins that
+     * thread's free list, which is capped: past the cap, a slab's worth of blocks is parked in a
+     * shared list, and a pool that runs dry adopts parked blocks before carving a new slab. So when
+     * one thread allocates and another frees, the blocks flow back instead of piling up. When a
+     * thread exits, its free blocks are parked the same way.
+     *
+     * @tparam Size The size of a block in bytes.
+     * @tparam Align The alignment of a block.
+     * @tparam Tag Pools with different tags never share blocks.
+     */
+    template <std::size_t Size, std::size_t Align, typename Tag>
+    class NodePool {
+    private:
+        union Block {
+            Block* next;
+            alignas(Align) unsigned char storage[Size];
+        };
+
+        static const std::size_t SLAB_BYTES = 64 * 1024;
+        static const std::size_t BLOCKS_PER_SLAB = SLAB_BYTES / sizeof(Block) > 0 ? SLAB_BYTES / sizeof(Block) : 1;
+        static const std::size_t LOCAL_LIMIT = 2 * BLOCKS_PER_SLAB;
+
+        struct Shared {
+            std::mutex lock;
+            std::vector<void*> slabs;
+            Block* orphans = nullptr;
+            std::size_t orphanCount = 0;
+        };
+
+        Block* freeList;
+        std::size_t freeCount;
+
+        NodePool() : freeList(nullptr), freeCount(0) {}
+
+        static Shared& shared() {
+            // intentionally leaked, nodes may outlive every static object
+            static Shared* state = new Shared();
+            return *state;
+        }
+
+        // parks the first count blocks of the free list in the shared list
+        void park(std::size_t count) {
+            Block* first = freeList;
+            Block* last = first;
+            for (std::size_t i = 1; i < count; ++i) {
+                last = last->next;
+            }
+            freeList = last->next;
+            freeCount -= count;
+            Shared& state = shared();
+            std::lock_guard<std::mutex> guard(state.lock);
+            last->next = state.orphans;
+            state.orphans = first;
+            state.orphanCount += count;
+        }
+
+        void refill() {
+            Shared& state = shared();
+            std::lock_guard<std::mutex> guard(state.lock);
+            if (state.orphans) {
+                // adopt at most a slab's worth, leaving the rest to other pools
+                std::size_t count = state.orphanCount < BLOCKS_PER_SLAB ? state.orphanCount : BLOCKS_PER_SLAB;
+                Block* last = state.orphans;
+                for (std::size_t i = 1; i < count; ++i) {
+                    last = last->next;
+                }
+                freeList = state.orphans;
+                state.orphans = last->next;
+                state.orphanCount -= count;
+                last->next = nullptr;
+                freeCount = count;
+                return;
+            }
+            Block* slab = static_cast<Block*>(::operator new(BLOCKS_PER_SLAB * sizeof(Block)));
+            state.slabs.push_back(slab);
+            for (std::size_t i = BLOCKS_PER_SLAB; i > 0; --i) {
+                slab[i - 1].next = freeList;
+                freeList = &slab[i - 1];
+            }
+            freeCount = BLOCKS_PER_SLAB;
+        }
+
+    public:
+        NodePool(const NodePool&) = delete;
+        NodePool& operator=(const NodePool&) = delete;
+
+        ~NodePool() {
+            if (freeList) {
+                park(freeCount);
+            }
+        }
+
+        /**
+         * @brief Gets the calling thread's pool.
+         */
+        static NodePool& instance() {
+            thread_local NodePool pool;
+            return pool;
+        }
+
+        /**
+         * @brief Gets the number of slabs carved so far by the pools of every thread.
+         */
+        static std::size_t slabCount() {
+            Shared& state = shared();
+            std::lock_guard<std::mutex> guard(state.lock);
+            return state.slabs.size();
+        }
+
+        void* allocate() {
+            if (!freeList) {
+                refill();
+            }
+            Block* block = freeList;
+            freeList = block->next;
+            freeCount--;
+            return block;
+        }
+
+        void deallocate(void* pointer) {
+            Block* block = static_cast<Block*>(pointer);
+            block->next = freeList;
+            freeList = block;
+            if (++freeCount > LOCAL_LIMIT) {
+                park(BLOCKS_PER_SLAB);
+            }
+        }
+    };
+
+    /**
+     * @brief Node allocator backed by a NodePool.
+     *
+     * Every list instantiated with the same Tag draws from the same pool, so insert/remove churn
+     * and whole-list copies recycle nodes instead of calling the global allocator. Give a list a
+     * distinct Tag to keep its nodes apart from everybody else's.
+     */
+    template <typename Tag = void>
+    struct PoolAllocator {
+        template <typename Node>
+        static void* allocate() {
+            return NodePool<sizeof(Node), alignof(Node), Tag>::instance().allocate();
+        }
+
+        template <typename Node>
+        static void deallocate(void* block) {
+            NodePool<sizeof(Node), alignof(Node), Tag>::instance().deallocate(block);
+        }
+    };
+
+}
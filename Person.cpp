@@ -1,51 +1,265 @@
-
 #include "Person.h"
-using std::endl;
 
-// Constructor
+namespace {
+
+    // what getTasks(type) returns for a type whose list was never allocated
+    const Person::TaskList& emptyList() {
+        static const Person::TaskList empty;
+        return empty;
+    }
+
+}
+
+// Constructors
 Person::Person(const string &name) : m_name(name) {}
 
+Person::Person(const Person& other) : m_name(other.m_name) {
+    for (int type = 0; type < TASK_TYPE_COUNT; type++) {
+        if (other.m_tasksByType[type]) {
+            m_tasksByType[type] = std::make_unique<TaskList>(*other.m_tasksByType[type]);
+        }
+    }
+}
+
+Person& Person::operator=(const Person& other) {
+    if (this != &other) {
+        Person copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+Person::TaskList& Person::listFor(int type) {
+    if (!m_tasksByType[type]) {
+        m_tasksByType[type] = std::make_unique<TaskList>();
+    }
+    return *m_tasksByType[type];
+}
+
 // Getters and setters
-string Person::getName() const {
+const string& Person::getName() const {
     return m_name;
 }
 
-const SortedList<Task>& Person::getTasks() const {
-    return m_tasks;
+Person::TaskRange Person::getTasks() const {
+    return TaskRange(this);
+}
+
+const Person::TaskList& Person::getTasks(TaskType type) const {
+    const std::unique_ptr<TaskList>& list = m_tasksByType[static_cast<int>(type)];
+    return list ? *list : emptyList();
+}
+
+void Person::setTasks(const TaskList& tasks) {
+    for (std::unique_ptr<TaskList>& list : m_tasksByType) {
+        list.reset();
+    }
+    for (const Task& task : tasks) {
+        assignTask(task);
+    }
+}
+
+void Person::setTasks(TaskType type, TaskList&& tasks) {
+    listFor(static_cast<int>(type)) = std::move(tasks);
 }
 
-void Person::setTasks(const SortedList<Task>& tasks) {
-    m_tasks = tasks;
+int Person::taskCount() const {
+    int count = 0;
+    for (const std::unique_ptr<TaskList>& list : m_tasksByType) {
+        count += list ? list->length() : 0;
+    }
+    return count;
 }
 
 // Other methods
-void Person::assignTask(const Task& task) {
-    m_tasks.insert(task);
+const void* Person::assignTask(const Task& task) {
+    TaskList& tasks = listFor(static_cast<int>(task.getType()));
+    return tasks.handle(tasks.insert(task));
 }
 
+const void* Person::assignTask(Task&& task) {
+    TaskList& tasks = listFor(static_cast<int>(task.getType()));
+    return tasks.handle(tasks.insert(std::move(task)));
+}
 
-int Person::completeTask() {
-    if (m_tasks.length() == 0) {
+int Person::highestPriorityType() const {
+    int best = -1;
+    for (int type = 0; type < TASK_TYPE_COUNT; type++) {
+        if (!m_tasksByType[type] || m_tasksByType[type]->length() == 0) {
+            continue;
+        }
+        if (best < 0 || m_tasksByType[type]->front() > m_tasksByType[best]->front()) {
+            best = type;
+        }
+    }
+    if (best < 0) {
+        throw std::runtime_error("No tasks assigned to this person.");
+    }
+    return best;
+}
+
+int Person::lowestPriorityType() const {
+    int worst = -1;
+    for (int type = 0; type < TASK_TYPE_COUNT; type++) {
+        if (!m_tasksByType[type] || m_tasksByType[type]->length() == 0) {
+            continue;
+        }
+        if (worst < 0 || m_tasksByType[worst]->back() > m_tasksByType[type]->back()) {
+            worst = type;
+        }
+    }
+    if (worst < 0) {
         throw std::runtime_error("No tasks assigned to this person.");
     }
-    int taskId = (*m_tasks.begin()).getId();
-    m_tasks.remove(m_tasks.begin());
+    return worst;
+}
+
+int Person::completeTask() {
+    TaskList& tasks = *m_tasksByType[highestPriorityType()];
+    int taskId = tasks.front().getId();
+    tasks.pop_front();
     return taskId;
 }
 
 const Task& Person::getHighestPriorityTask() const {
-    if (m_tasks.length() == 0) {
-        throw std::runtime_error("No tasks assigned to this person.");
+    return m_tasksByType[highestPriorityType()]->front();
+}
+
+const Task& Person::getLowestPriorityTask() const {
+    return m_tasksByType[lowestPriorityType()]->back();
+}
+
+int Person::removeLowestPriorityTask() {
+    TaskList& tasks = *m_tasksByType[lowestPriorityType()];
+    int taskId = tasks.back().getId();
+    tasks.pop_back();
+    return taskId;
+}
+
+void Person::bumpPriorityByType(TaskType type, int priorityBump) {
+    std::unique_ptr<TaskList>& tasks = m_tasksByType[static_cast<int>(type)];
+    if (!tasks) {
+        return;
+    }
+    tasks->transform([priorityBump](Task& task) {
+        task.setPriority(task.getPriority() + priorityBump);
+    });
+}
+
+const Task* Person::findTask(const Task& key, const void* handle) const {
+    const TaskList& tasks = getTasks(key.getType());
+    TaskList::ConstIterator it = handle ? tasks.at(handle) : tasks.find(key);
+    if (!(it != tasks.end())) {
+        return nullptr;
+    }
+    return &*it;
+}
+
+bool Person::cancelTask(const Task& key, const void* handle) {
+    if (!m_tasksByType[static_cast<int>(key.getType())]) {
+        return false;
+    }
+    TaskList& tasks = *m_tasksByType[static_cast<int>(key.getType())];
+    TaskList::ConstIterator it = handle ? tasks.at(handle) : tasks.find(key);
+    if (!(it != tasks.end())) {
+        return false;
     }
-    return (*m_tasks.begin());
+    tasks.remove(it);
+    return true;
+}
+
+bool Person::setTaskPriority(const Task& key, int priority, const void* handle) {
+    if (!m_tasksByType[static_cast<int>(key.getType())]) {
+        return false;
+    }
+    TaskList& tasks = *m_tasksByType[static_cast<int>(key.getType())];
+    TaskList::ConstIterator it = handle ? tasks.at(handle) : tasks.find(key);
+    if (!(it != tasks.end())) {
+        return false;
+    }
+    tasks.modify(it, [priority](Task& task) {
+        task.setPriority(priority);
+    });
+    return true;
 }
 
 // Overloaded operators
 ostream& operator<<(ostream& os, const Person& person) {
-    os << "Person: " << person.m_name << endl;
-    // Assuming the SortedList has an appropriate method to list tasks
-    for (const Task& t: person.m_tasks) {
-        os << t << endl;
+    // '\n' rather than endl, flushing is left to the caller
+    os << "Person: " << person.m_name << '\n';
+    for (const Task& t: person.getTasks()) {
+        os << t << '\n';
     }
     return os;
 }
+
+// Task range
+Person::TaskRange::TaskRange(const Person* person) : person(person) {}
+
+Person::ConstIterator Person::TaskRange::begin() const {
+    return ConstIterator(person);
+}
+
+Person::ConstIterator Person::TaskRange::end() const {
+    return ConstIterator();
+}
+
+int Person::TaskRange::length() const {
+    return person->taskCount();
+}
+
+// Iterator
+Person::ConstIterator::ConstIterator() : person(nullptr), cursorCount(0), current(-1), remaining(0) {}
+
+Person::ConstIterator::ConstIterator(const Person* person)
+    : person(person), cursorCount(0), current(-1), remaining(0) {
+    for (const std::unique_ptr<TaskList>& list : person->m_tasksByType) {
+        if (list && list->length() > 0) {
+            cursors[cursorCount++].emplace(list->begin(), list->end());
+            remaining += list->length();
+        }
+    }
+    pickCurrent();
+}
+
+void Person::ConstIterator::pickCurrent() {
+    current = -1;
+    for (int i = 0; i < cursorCount; i++) {
+        if (!(cursors[i]->first != cursors[i]->second)) {
+            continue;
+        }
+        if (current < 0 || *cursors[i]->first > *cursors[current]->first) {
+            current = i;
+        }
+    }
+}
+
+const Task& Person::ConstIterator::operator*() const {
+    if (current < 0) {
+        throw std::range_error("Dereferencing end iterator");
+    }
+    return *cursors[current]->first;
+}
+
+Person::ConstIterator& Person::ConstIterator::operator++() {
+    if (current < 0) {
+        throw std::out_of_range("Incrementing end iterator");
+    }
+    ++cursors[current]->first;
+    remaining--;
+    pickCurrent();
+    return *this;
+}
+
+bool Person::ConstIterator::operator==(const ConstIterator& other) const {
+    // every end iterator is equal, whichever person it came from
+    if (current < 0 || other.current < 0) {
+        return current < 0 && other.current < 0;
+    }
+    return person == other.person && remaining == other.remaining &&
+           !(cursors[current]->first != other.cursors[other.current]->first);
+}
+
+bool Person::ConstIterator::operator!=(const ConstIterator& other) const {
+    return !(*this == other);
+}
@@ -2,9 +2,14 @@
 #pragma once
 
 #include <iostream>
+#include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include "Task.h"
 #include "SortedList.h"
+#include "FlatSortedList.h"
+#include "TaskBucketQueue.h"
 
 using mtm::SortedList;
 using std::ostream;
@@ -12,11 +17,42 @@ using std::string;
 
 /**
  * @brief Class representing a person who can have tasks assigned.
+ *
+ * The tasks are kept in one list per TaskType, so work on the tasks of one type (such as
+ * bumping their priority) touches only those tasks. The highest priority task is the greatest
+ * of the heads of the lists, and iterating over all the tasks merges the lists on the fly.
+ * A list is allocated the first time a task of its type is assigned, so a person without
+ * tasks costs a name and a few null pointers.
  */
 class Person {
+public:
+    /**
+     * @brief The container holding a person's tasks, ordered from highest to lowest priority.
+     *
+     * Uses a TaskBucketQueue, so assigning and completing a task are O(1) and tasks of equal
+     * priority are completed in the order they were assigned. Define MTM_SKIPLIST_TASK_LIST to
+     * keep the tasks in a skip-list SortedList, or MTM_FLAT_TASK_LIST for a contiguous
+     * FlatSortedList.
+     */
+#if defined(MTM_FLAT_TASK_LIST)
+    typedef mtm::FlatSortedList<Task> TaskList;
+#elif defined(MTM_SKIPLIST_TASK_LIST)
+    typedef SortedList<Task, mtm::SkipListBackend> TaskList;
+#else
+    typedef TaskBucketQueue TaskList;
+#endif
+
+    class ConstIterator;
+    class TaskRange;
+
 private:
     string m_name;
-    SortedList<Task> m_tasks;
+    // null until the first task of the type is assigned
+    std::unique_ptr<TaskList> m_tasksByType[TASK_TYPE_COUNT];
+
+    TaskList& listFor(int type);
+    int highestPriorityType() const;
+    int lowestPriorityType() const;
 
 public:
     /**
@@ -26,33 +62,85 @@ public:
      */
     Person(const string& name = "");
 
+    /**
+     * @brief Copy constructor, copying only the lists that were allocated.
+     *
+     * @param other The person to copy.
+     */
+    Person(const Person& other);
+
+    /**
+     * @brief Copy assignment operator.
+     *
+     * @param other The person to copy.
+     * @return Person& This person.
+     */
+    Person& operator=(const Person& other);
+
+    Person(Person&& other) noexcept = default;
+    Person& operator=(Person&& other) noexcept = default;
+    ~Person() = default;
+
     /**
      * @brief Gets the name of the person.
      *
-     * @return string The name of the person.
+     * @return const string& The name of the person.
+     */
+    const string& getName() const;
+
+    /**
+     * @brief Gets the tasks assigned to the person.
+     *
+     * @return TaskRange The tasks assigned to the person, from highest to lowest priority.
      */
-    string getName() const;
+    TaskRange getTasks() const;
 
     /**
-     * @brief Gets the list of tasks assigned to the person.
+     * @brief Gets the tasks of one type assigned to the person.
      *
-     * @return const SortedList<Task>& The list of tasks assigned to the person.
+     * @param type The type of the tasks.
+     * @return const TaskList& The list of tasks of this type.
      */
-    const SortedList<Task>& getTasks() const;
+    const TaskList& getTasks(TaskType type) const;
 
     /**
      * @brief Sets the list of tasks for the person.
      *
      * @param tasks The list of tasks to be set.
      */
-    void setTasks(const SortedList<Task>& tasks);
+    void setTasks(const TaskList& tasks);
+
+    /**
+     * @brief Replaces the tasks of one type with a list that holds only tasks of that type.
+     *
+     * @param type The type of the tasks.
+     * @param tasks The new list, taken over without copying.
+     */
+    void setTasks(TaskType type, TaskList&& tasks);
+
+    /**
+     * @brief Gets the number of tasks assigned to the person.
+     *
+     * @return int The number of tasks.
+     */
+    int taskCount() const;
 
     /**
      * @brief Assigns a new task to the person.
      *
      * @param task The task to be assigned.
+     * @return const void* A handle to the task for findTask, cancelTask and setTaskPriority, valid
+     * until the task is removed; nullptr if the TaskList has no stable handles.
      */
-    void assignTask(const Task& task);
+    const void* assignTask(const Task& task);
+
+    /**
+     * @brief Assigns a new task to the person, moving it into the task list.
+     *
+     * @param task The task to be assigned.
+     * @return const void* A handle to the task, as for the copying overload.
+     */
+    const void* assignTask(Task&& task);
 
     /**
      * @brief Completes the highest priority task from the list of tasks.
@@ -68,6 +156,67 @@ public:
      */
     const Task& getHighestPriorityTask() const;
 
+    /**
+     * @brief Gets the lowest priority task assigned to the person, the last one they would complete.
+     *
+     * @return const Task& The lowest priority task.
+     */
+    const Task& getLowestPriorityTask() const;
+
+    /**
+     * @brief Removes the lowest priority task, for example to hand it over to someone else.
+     *
+     * @return int The ID of the removed task.
+     */
+    int removeLowestPriorityTask();
+
+    /**
+     * @brief Bumps the priority of all the tasks of a type, in place.
+     *
+     * Only the list of this type is touched. Its tasks keep their relative order, so they are
+     * re-sorted only where the priority cap of 100 made some of them equal.
+     *
+     * @param type The type of the tasks to bump.
+     * @param priorityBump The amount added to the priority of each task.
+     */
+    void bumpPriorityByType(TaskType type, int priorityBump);
+
+    /**
+     * @brief Finds an assigned task by its type, priority and ID.
+     *
+     * Searches only the list of key's type, with the search of the underlying TaskList. Given the
+     * task's handle, goes straight to it instead.
+     *
+     * @param key A task with the type, priority and ID of the task to find.
+     * @param handle The handle assignTask returned for the task, or nullptr to search.
+     * @return const Task* The task, or nullptr if the person has no such task.
+     */
+    const Task* findTask(const Task& key, const void* handle = nullptr) const;
+
+    /**
+     * @brief Removes an assigned task, found by its type, priority and ID.
+     *
+     * @param key A task with the type, priority and ID of the task to remove.
+     * @param handle The handle assignTask returned for the task, or nullptr to search.
+     * @return true If the task was found and removed.
+     * @return false Otherwise.
+     */
+    bool cancelTask(const Task& key, const void* handle = nullptr);
+
+    /**
+     * @brief Changes the priority of an assigned task, found by its type, priority and ID.
+     *
+     * The task is moved to its new position in its list rather than reinserted.
+     *
+     * @param key A task with the type, priority and ID of the task to change.
+     * @param priority The new priority, enforced to be in range [0, 100].
+     * @param handle The handle assignTask returned for the task, or nullptr to search. The task
+     * keeps its handle.
+     * @return true If the task was found and changed.
+     * @return false Otherwise.
+     */
+    bool setTaskPriority(const Task& key, int priority, const void* handle = nullptr);
+
     /**
      * @brief Overloaded output stream operator for printing Person details.
      *
@@ -77,3 +226,46 @@ public:
      */
     friend ostream &operator<<(ostream &os, const Person &person);
 };
+
+/**
+ * @brief Iterator over all of a person's tasks, merging the per-type lists by priority.
+ *
+ * The cursors live in the iterator itself, so taking one allocates nothing.
+ */
+class Person::ConstIterator {
+    typedef TaskList::ConstIterator ListIterator;
+
+    const Person* person;
+    // the current and the end position in every non-empty list, the first cursorCount are set
+    std::optional<std::pair<ListIterator, ListIterator>> cursors[TASK_TYPE_COUNT];
+    int cursorCount;
+    // the cursor holding the next task, -1 at the end
+    int current;
+    int remaining;
+
+    ConstIterator();
+    explicit ConstIterator(const Person* person);
+    void pickCurrent();
+    friend class Person;
+
+public:
+    const Task& operator*() const;
+    ConstIterator& operator++();
+    bool operator==(const ConstIterator& other) const;
+    bool operator!=(const ConstIterator& other) const;
+};
+
+/**
+ * @brief All of a person's tasks, from highest to lowest priority, for range-based for loops.
+ */
+class Person::TaskRange {
+    const Person* person;
+
+    explicit TaskRange(const Person* person);
+    friend class Person;
+
+public:
+    ConstIterator begin() const;
+    ConstIterator end() const;
+    int length() const;
+};
@@ -0,0 +1,89 @@
+#include "PersonRegistry.h"
+
+// Constructor
+PersonRegistry::PersonRegistry() : m_table(16, Entry{0, EMPTY}) {}
+
+// Hashing
+uint32_t PersonRegistry::hashName(const string& name) {
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (unsigned char c : name) {
+        hash ^= c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+int PersonRegistry::probe(const string& name, uint32_t hash) const {
+    // returns the table index holding name, or the empty index where it would go
+    size_t mask = m_table.size() - 1;
+    size_t index = hash & mask;
+    while (true) {
+        const Entry& entry = m_table[index];
+        if (entry.slot == EMPTY) {
+            return static_cast<int>(index);
+        }
+        if (entry.hash == hash && m_persons[entry.slot].getName() == name) {
+            return static_cast<int>(index);
+        }
+        index = (index + 1) & mask;
+    }
+}
+
+void PersonRegistry::grow() {
+    std::vector<Entry> table(m_table.size() * 2, Entry{0, EMPTY});
+    size_t mask = table.size() - 1;
+    for (const Entry& entry : m_table) {
+        if (entry.slot == EMPTY) {
+            continue;
+        }
+        size_t index = entry.hash & mask;
+        while (table[index].slot != EMPTY) {
+            index = (index + 1) & mask;
+        }
+        table[index] = entry;
+    }
+    m_table.swap(table);
+}
+
+// Lookup
+int PersonRegistry::find(const string& name) const {
+    return m_table[probe(name, hashName(name))].slot;
+}
+
+int PersonRegistry::findOrAdd(const string& name) {
+    uint32_t hash = hashName(name);
+    int index = probe(name, hash);
+    if (m_table[index].slot != EMPTY) {
+        return m_table[index].slot;
+    }
+    // keep the load factor at most 1/2 so probe sequences stay short
+    if ((m_persons.size() + 1) * 2 > m_table.size()) {
+        grow();
+        index = probe(name, hash);
+    }
+    m_persons.emplace_back(name);
+    m_table[index] = Entry{hash, static_cast<int>(m_persons.size()) - 1};
+    return m_table[index].slot;
+}
+
+// Access
+int PersonRegistry::size() const {
+    return static_cast<int>(m_persons.size());
+}
+
+Person& PersonRegistry::operator[](int slot) {
+    return m_persons[slot];
+}
+
+const Person& PersonRegistry::operator[](int slot) const {
+    return m_persons[slot];
+}
+
+PersonRegistry::ConstIterator PersonRegistry::begin() const {
+    return m_persons.begin();
+}
+
+PersonRegistry::ConstIterator PersonRegistry::end() const {
+    return m_persons.end();
+}
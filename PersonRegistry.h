@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Person.h"
+
+using std::string;
+
+/**
+ * @brief Lightweight reference to a person: the person's dense slot in a PersonRegistry.
+ *
+ * Resolve a name to a handle once, then use the handle for any number of operations without
+ * hashing or comparing the name again. A handle is only meaningful to the manager that issued it:
+ * it does not record its owner, so another manager's handle that happens to be in range refers to
+ * whoever holds that slot there.
+ */
+struct PersonHandle {
+    int id;
+
+    explicit PersonHandle(int id) : id(id) {}
+};
+
+/**
+ * @brief Growable collection of persons, looked up by name through an open-addressing hash table.
+ *
+ * Persons are stored densely in the order they were added; that position is the person's slot and
+ * never changes. The table maps a name to its slot with linear probing and keeps each entry's hash,
+ * so a lookup compares strings only on a full hash match. Lookups are O(1) on average.
+ */
+class PersonRegistry {
+private:
+    struct Entry {
+        uint32_t hash;
+        int slot;
+    };
+
+    static const int EMPTY = -1;
+
+    std::vector<Person> m_persons;
+    std::vector<Entry> m_table;
+
+    static uint32_t hashName(const string& name);
+    int probe(const string& name, uint32_t hash) const;
+    void grow();
+
+public:
+    /**
+     * @brief Constructor to create an empty registry.
+     */
+    PersonRegistry();
+
+    /**
+     * @brief Finds the slot of a person.
+     *
+     * @param name The name of the person.
+     * @return int The slot of the person, or -1 if no person has this name.
+     */
+    int find(const string& name) const;
+
+    /**
+     * @brief Finds the slot of a person, adding the person if needed.
+     *
+     * @param name The name of the person.
+     * @return int The slot of the person.
+     */
+    int findOrAdd(const string& name);
+
+    /**
+     * @brief Gets the number of persons in the registry.
+     *
+     * @return int The number of persons.
+     */
+    int size() const;
+
+    /**
+     * @brief Gets the person in a slot.
+     *
+     * @param slot The slot, in the range [0, size()).
+     * @return Person& The person in the slot.
+     */
+    Person& operator[](int slot);
+
+    /**
+     * @brief Gets the person in a slot.
+     *
+     * @param slot The slot, in the range [0, size()).
+     * @return const Person& The person in the slot.
+     */
+    const Person& operator[](int slot) const;
+
+    typedef std::vector<Person>::const_iterator ConstIterator;
+
+    /**
+     * @brief Iterates over the persons in slot order.
+     */
+    ConstIterator begin() const;
+    ConstIterator end() const;
+};
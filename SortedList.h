@@ -1,28 +1,104 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <iostream>
+#include <new>
 #include <stdexcept>
+#include <utility>
+#include <vector>
+#include "NodePool.h"
 
 namespace mtm {
 
-    template <typename T>
+    /**
+     * @brief Backend storing the list as a plain singly linked list.
+     *
+     * Insert and remove walk the list from the head, O(n).
+     */
+    struct LinkedListBackend {
+        static const int MAX_LEVEL = 1;
+    };
+
+    /**
+     * @brief Backend storing the list as a skip list.
+     *
+     * Every node keeps up to MAX_LEVEL forward pointers; a node reaches level i+1 with
+     * probability 1/4, which gives expected O(log n) insert and remove. Level 0 is the
+     * ordinary linked list, so iteration is unchanged.
+     */
+    struct SkipListBackend {
+        static const int MAX_LEVEL = 16;
+    };
+
+    /**
+     * @brief Tag telling a SortedList range constructor that the range is already in list order.
+     */
+    struct AlreadySorted {};
+
+    template <typename List>
+    class ListView;
+
+    template <typename T, typename Backend = LinkedListBackend, typename Alloc = PoolAllocator<>>
     class SortedList {
     private:
+        static const int MAX_LEVEL = Backend::MAX_LEVEL;
+
         struct Node {
             T data;
-            Node* next;
-            explicit Node(const T& data, Node* next = nullptr) : data(data), next(next) {}
+            int height;
+            // the id of the list the node is linked into, which checks an iterator in O(1)
+            std::uint32_t owner;
+            // prev is the predecessor on level 0, next[i] the successor on level i
+            Node* prev;
+            Node* next[MAX_LEVEL];
+            template <typename... Args>
+            explicit Node(int height, Args&&... args)
+                : data(std::forward<Args>(args)...), height(height), owner(0), prev(nullptr) {
+                for (int i = 0; i < MAX_LEVEL; ++i) {
+                    next[i] = nullptr;
+                }
+            }
         };
 
-        Node* Head;
-
+        // Head[i] is the first node reaching level i, Head[0] is the first node of the list
+        Node* Head[MAX_LEVEL];
+        int level;
+        int size;
+        unsigned int seed;
+        // unique among the live lists of this type; a moved list takes it along with its nodes
+        std::uint32_t id;
+
+        static std::uint32_t newId();
+        template <typename... Args>
+        Node* createNode(int height, Args&&... args);
+        void destroyNode(Node* node);
         void Delete();
         void copyFrom(const SortedList& other);
+        void assignFrom(const SortedList& other);
+        void relink();
+        void linkNode(Node* node);
+        void unlinkNode(Node* node, Node* const* update);
+        bool findPredecessors(Node* target, Node** update);
+        void detachNode(Node* node);
+        Node* detachAll();
+        Node* lastNode() const;
+        void mergeChain(Node* chain);
+        static Node* sortChain(Node* chain);
+        int randomLevel();
+        Node*& link(Node* prev, int lvl);
 
     public:
         SortedList();
         SortedList(const SortedList& other);
+        SortedList(SortedList&& other) noexcept;
+        template <typename InputIterator>
+        SortedList(InputIterator first, InputIterator last);
+        template <typename InputIterator>
+        SortedList(AlreadySorted, InputIterator first, InputIterator last);
         SortedList& operator=(const SortedList& other);
+        SortedList& operator=(SortedList&& other) noexcept;
         ~SortedList();
 
         class ConstIterator;
@@ -30,17 +106,48 @@ namespace mtm {
         ConstIterator end();
         ConstIterator begin() const;
         ConstIterator end() const;
-        void insert(const T& data);
+        ConstIterator insert(const T& data);
+        ConstIterator insert(T&& data);
+        template <typename... Args>
+        void emplace(Args&&... args);
         void remove(const ConstIterator& it);
+        template<typename Operation>
+        void modify(const ConstIterator& it, Operation op);
+        ConstIterator find(const T& key) const;
+
+        /**
+         * @brief Gets a handle to the element at it, valid until the element is removed.
+         *
+         * The handle is the element's node, which modify, transform and moving the list keep.
+         */
+        const void* handle(const ConstIterator& it) const;
+
+        /**
+         * @brief Gets an iterator to the element of a handle taken from this list, in O(1).
+         */
+        ConstIterator at(const void* handle) const;
+
+        const T& front() const;
+        void pop_front();
+        const T& back() const;
+        void pop_back();
         int length() const;
+        void merge(const SortedList& other);
+        void merge(SortedList&& other);
+        void splice(SortedList& other);
+        void splice(SortedList& other, const ConstIterator& first, const ConstIterator& last);
+        SortedList split(const ConstIterator& position);
+        template<typename Operation>
+        void transform(Operation op);
+        ListView<SortedList> view() const;
         template<typename Predicate>
-        SortedList<T> filter(Predicate predicate) const;
+        SortedList filter(Predicate predicate) const;
         template<typename Operation>
-        SortedList<T> apply(Operation op) const;
+        SortedList apply(Operation op) const;
     };
 
-    template <class T>
-    class SortedList<T>::ConstIterator {
+    template <class T, class Backend, class Alloc>
+    class SortedList<T, Backend, Alloc>::ConstIterator {
         Node* node;
         explicit ConstIterator(Node* node);
         friend class SortedList;
@@ -55,167 +162,668 @@ namespace mtm {
         bool operator!=(const ConstIterator& other) const;
     };
 
-    template <class T>
-    void SortedList<T>::Delete() {
-        Node* current = Head;
+    template <class T, class Backend, class Alloc>
+    template <typename... Args>
+    typename SortedList<T, Backend, Alloc>::Node* SortedList<T, Backend, Alloc>::createNode(int height, Args&&... args) {
+        void* block = Alloc::template allocate<Node>();
+        try {
+            Node* node = new (block) Node(height, std::forward<Args>(args)...);
+            node->owner = id;
+            return node;
+        } catch (...) {
+            Alloc::template deallocate<Node>(block);
+            throw;
+        }
+    }
+
+    template <class T, class Backend, class Alloc>
+    void SortedList<T, Backend, Alloc>::destroyNode(Node* node) {
+        node->~Node();
+        Alloc::template deallocate<Node>(node);
+    }
+
+    template <class T, class Backend, class Alloc>
+    void SortedList<T, Backend, Alloc>::Delete() {
+        Node* current = Head[0];
         while (current) {
-            Node* next = current->next;
-            delete current;
+            Node* next = current->next[0];
+            destroyNode(current);
             current = next;
         }
-        Head = nullptr;
+        for (int i = 0; i < MAX_LEVEL; ++i) {
+            Head[i] = nullptr;
+        }
+        level = 1;
+        size = 0;
     }
 
-    template <class T>
-    void SortedList<T>::copyFrom(const SortedList& other) {
-        if (other.Head == nullptr) {
-            Head = nullptr;
-            return;
-        }
+    template <class T, class Backend, class Alloc>
+    void SortedList<T, Backend, Alloc>::copyFrom(const SortedList& other) {
         Delete();
-        // Copy the first node
-        Head = new Node(other.Head->data);
-        Node* current = Head;
-        Node* otherCurrent = other.Head->next;
+        // Append every node of other at the tail of each of its levels, keeping its height
+        Node* tails[MAX_LEVEL] = {};
+        try {
+            for (Node* otherCurrent = other.Head[0]; otherCurrent; otherCurrent = otherCurrent->next[0]) {
+                Node* node = createNode(otherCurrent->height, otherCurrent->data);
+                node->prev = tails[0];
+                size++;
+                for (int lvl = 0; lvl < node->height; ++lvl) {
+                    link(tails[lvl], lvl) = node;
+                    tails[lvl] = node;
+                }
+            }
+        } catch (...) {
+            Delete();
+            throw;
+        }
+        level = other.level;
+    }
 
-        // Copy the remaining nodes
-        while (otherCurrent) {
-            current->next = new Node(otherCurrent->data);
-            current = current->next;
-            otherCurrent = otherCurrent->next;
+    template <class T, class Backend, class Alloc>
+    void SortedList<T, Backend, Alloc>::assignFrom(const SortedList& other) {
+        // Overwrite the nodes we already own, then trim or extend the tail
+        Node** current = &Head[0];
+        try {
+            for (Node* otherCurrent = other.Head[0]; otherCurrent; otherCurrent = otherCurrent->next[0]) {
+                if (*current) {
+                    (*current)->data = otherCurrent->data;
+                } else {
+                    *current = createNode(otherCurrent->height, otherCurrent->data);
+                }
+                current = &(*current)->next[0];
+            }
+        } catch (...) {
+            Delete();
+            throw;
+        }
+        Node* extra = *current;
+        *current = nullptr;
+        while (extra) {
+            Node* next = extra->next[0];
+            destroyNode(extra);
+            extra = next;
         }
+        relink();
     }
 
-    template <class T>
-    SortedList<T>::SortedList() : Head(nullptr) {}
+    template <class T, class Backend, class Alloc>
+    void SortedList<T, Backend, Alloc>::relink() {
+        // Rebuild the back links and levels 1 and up from the level 0 order and the height of every node
+        Node* tails[MAX_LEVEL] = {};
+        level = 1;
+        size = 0;
+        for (Node* current = Head[0]; current; current = current->next[0]) {
+            current->prev = tails[0];
+            current->owner = id;
+            tails[0] = current;
+            size++;
+            for (int lvl = 1; lvl < current->height; ++lvl) {
+                link(tails[lvl], lvl) = current;
+                tails[lvl] = current;
+            }
+            if (current->height > level) {
+                level = current->height;
+            }
+        }
+        for (int lvl = 1; lvl < MAX_LEVEL; ++lvl) {
+            link(tails[lvl], lvl) = nullptr;
+        }
+    }
+
+    template <class T, class Backend, class Alloc>
+    typename SortedList<T, Backend, Alloc>::Node* SortedList<T, Backend, Alloc>::detachAll() {
+        Node* chain = Head[0];
+        for (int i = 0; i < MAX_LEVEL; ++i) {
+            Head[i] = nullptr;
+        }
+        level = 1;
+        size = 0;
+        return chain;
+    }
+
+    template <class T, class Backend, class Alloc>
+    void SortedList<T, Backend, Alloc>::mergeChain(Node* chain) {
+        // Linear merge on level 0; elements of chain go before equal elements already in the list,
+        // just like insert() would place them
+        Node** current = &Head[0];
+        while (chain) {
+            while (*current && (*current)->data > chain->data) {
+                current = &(*current)->next[0];
+            }
+            Node* next = chain->next[0];
+            chain->next[0] = *current;
+            *current = chain;
+            current = &chain->next[0];
+            chain = next;
+        }
+        relink();
+    }
+
+    template <class T, class Backend, class Alloc>
+    int SortedList<T, Backend, Alloc>::randomLevel() {
+        int height = 1;
+        while (height < MAX_LEVEL) {
+            // xorshift32, two random bits per level give the 1/4 promotion probability
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            if ((seed & 3) != 0) {
+                break;
+            }
+            height++;
+        }
+        return height;
+    }
+
+    template <class T, class Backend, class Alloc>
+    typename SortedList<T, Backend, Alloc>::Node*& SortedList<T, Backend, Alloc>::link(Node* prev, int lvl) {
+        return prev ? prev->next[lvl] : Head[lvl];
+    }
 
-    template <class T>
-    SortedList<T>::SortedList(const SortedList<T>& other) : Head(nullptr) {
+    template <class T, class Backend, class Alloc>
+    std::uint32_t SortedList<T, Backend, Alloc>::newId() {
+        static std::atomic<std::uint32_t> next(1);
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    template <class T, class Backend, class Alloc>
+    SortedList<T, Backend, Alloc>::SortedList() : level(1), size(0), seed(0x9E3779B9u), id(newId()) {
+        for (int i = 0; i < MAX_LEVEL; ++i) {
+            Head[i] = nullptr;
+        }
+    }
+
+    template <class T, class Backend, class Alloc>
+    SortedList<T, Backend, Alloc>::SortedList(const SortedList& other) : SortedList() {
         copyFrom(other);
     }
 
-    template <class T>
-    SortedList<T>& SortedList<T>::operator=(const SortedList& other) {
+    template <class T, class Backend, class Alloc>
+    template <typename InputIterator>
+    SortedList<T, Backend, Alloc>::SortedList(InputIterator first, InputIterator last) : SortedList() {
+        // Sort the whole range once, then append; equal elements keep their order in the range
+        std::vector<T> items;
+        for (; first != last; ++first) {
+            items.push_back(*first);
+        }
+        auto greater = [](const T& lhs, const T& rhs) { return lhs > rhs; };
+        if (!std::is_sorted(items.begin(), items.end(), greater)) {
+            std::stable_sort(items.begin(), items.end(), greater);
+        }
+        Node** current = &Head[0];
+        try {
+            for (T& item : items) {
+                *current = createNode(randomLevel(), std::move(item));
+                current = &(*current)->next[0];
+            }
+        } catch (...) {
+            Delete();
+            throw;
+        }
+        relink();
+    }
+
+    template <class T, class Backend, class Alloc>
+    template <typename InputIterator>
+    SortedList<T, Backend, Alloc>::SortedList(AlreadySorted, InputIterator first, InputIterator last) : SortedList() {
+        // The caller guarantees the order, so every element is appended at the tail
+        Node** current = &Head[0];
+        try {
+            for (; first != last; ++first) {
+                *current = createNode(randomLevel(), *first);
+                current = &(*current)->next[0];
+            }
+        } catch (...) {
+            Delete();
+            throw;
+        }
+        relink();
+    }
+
+    template <class T, class Backend, class Alloc>
+    SortedList<T, Backend, Alloc>::SortedList(SortedList&& other) noexcept
+        : level(other.level), size(other.size), seed(other.seed), id(other.id) {
+        for (int i = 0; i < MAX_LEVEL; ++i) {
+            Head[i] = other.Head[i];
+            other.Head[i] = nullptr;
+        }
+        other.level = 1;
+        other.size = 0;
+        other.id = newId();
+    }
+
+    template <class T, class Backend, class Alloc>
+    SortedList<T, Backend, Alloc>& SortedList<T, Backend, Alloc>::operator=(const SortedList& other) {
         if (this != &other) {
-            SortedList<T> temp(other);
-            //using already existing swap function for any template;
-            copyFrom(temp);
+            assignFrom(other);
         }
         return *this;
     }
 
-    template <class T>
-    SortedList<T>::~SortedList() {
+    template <class T, class Backend, class Alloc>
+    SortedList<T, Backend, Alloc>& SortedList<T, Backend, Alloc>::operator=(SortedList&& other) noexcept {
+        if (this != &other) {
+            Delete();
+            for (int i = 0; i < MAX_LEVEL; ++i) {
+                Head[i] = other.Head[i];
+                other.Head[i] = nullptr;
+            }
+            level = other.level;
+            size = other.size;
+            id = other.id;
+            other.level = 1;
+            other.size = 0;
+            other.id = newId();
+        }
+        return *this;
+    }
+
+    template <class T, class Backend, class Alloc>
+    SortedList<T, Backend, Alloc>::~SortedList() {
         Delete();
     }
 
-    template <class T>
-    void SortedList<T>::insert(const T& data) {
-        Node* nodeToInsert = new Node(data);
+    template <class T, class Backend, class Alloc>
+    void SortedList<T, Backend, Alloc>::linkNode(Node* nodeToInsert) {
+        // update[i] is the last node on level i that is greater than the new data (nullptr for the head)
+        Node* update[MAX_LEVEL] = {};
+        Node* prev = nullptr;
+        for (int lvl = level - 1; lvl >= 0; --lvl) {
+            Node* next = link(prev, lvl);
+            while (next && next->data > nodeToInsert->data) {
+                prev = next;
+                next = next->next[lvl];
+            }
+            update[lvl] = prev;
+        }
 
-        if (!Head) {
-            Head = nodeToInsert;
-        } else if(nodeToInsert->data > Head->data){
-            nodeToInsert->next = Head;
-            Head = nodeToInsert;
-        } else {
-            Node* currentNode = Head;
-            while (currentNode->next && currentNode->next->data > data) {
-                currentNode = currentNode->next;
+        int height = nodeToInsert->height;
+        if (height > level) {
+            level = height;
+        }
+        for (int lvl = 0; lvl < height; ++lvl) {
+            Node*& prevLink = link(update[lvl], lvl);
+            nodeToInsert->next[lvl] = prevLink;
+            prevLink = nodeToInsert;
+        }
+        nodeToInsert->prev = update[0];
+        if (nodeToInsert->next[0]) {
+            nodeToInsert->next[0]->prev = nodeToInsert;
+        }
+        size++;
+    }
+
+    template <class T, class Backend, class Alloc>
+    void SortedList<T, Backend, Alloc>::unlinkNode(Node* target, Node* const* update) {
+        // update[i] is the predecessor of target on level i, level 0 uses the back link instead
+        link(target->prev, 0) = target->next[0];
+        if (target->next[0]) {
+            target->next[0]->prev = target->prev;
+        }
+        if constexpr (MAX_LEVEL > 1) {
+            for (int lvl = 1; lvl < target->height; ++lvl) {
+                link(update[lvl], lvl) = target->next[lvl];
+            }
+            while (level > 1 && Head[level - 1] == nullptr) {
+                level--;
+            }
+        }
+        size--;
+    }
+
+    template <class T, class Backend, class Alloc>
+    typename SortedList<T, Backend, Alloc>::ConstIterator SortedList<T, Backend, Alloc>::insert(const T& data) {
+        Node* node = createNode(randomLevel(), data);
+        linkNode(node);
+        return ConstIterator(node);
+    }
+
+    template <class T, class Backend, class Alloc>
+    typename SortedList<T, Backend, Alloc>::ConstIterator SortedList<T, Backend, Alloc>::insert(T&& data) {
+        Node* node = createNode(randomLevel(), std::move(data));
+        linkNode(node);
+        return ConstIterator(node);
+    }
+
+    template <class T, class Backend, class Alloc>
+    template <typename... Args>
+    void SortedList<T, Backend, Alloc>::emplace(Args&&... args) {
+        linkNode(createNode(randomLevel(), std::forward<Args>(args)...));
+    }
+
+    template <class T, class Backend, class Alloc>
+    bool SortedList<T, Backend, Alloc>::findPredecessors(Node* target, Node** update) {
+        // Searches for target itself, so a node of another list, even one shaped the same, is never found
+        if (target->height > level) {
+            return false;
+        }
+        Node* prev = nullptr;
+        for (int lvl = level - 1; lvl >= 0; --lvl) {
+            Node* next = link(prev, lvl);
+            if (lvl >= target->height) {
+                // target is not linked on this level, skip only the strictly greater nodes
+                while (next && next->data > target->data) {
+                    prev = next;
+                    next = next->next[lvl];
+                }
+            } else {
+                // target is linked here, walk through the run of equal nodes until reaching it
+                while (next && next != target && !(target->data > next->data)) {
+                    prev = next;
+                    next = next->next[lvl];
+                }
+                if (next != target) {
+                    return false;
+                }
             }
-            nodeToInsert->next = currentNode->next;
-            currentNode->next = nodeToInsert;
+            update[lvl] = prev;
         }
+        return true;
     }
 
-    template <class T>
-    void SortedList<T>::remove(const SortedList::ConstIterator &it) {
+    template <class T, class Backend, class Alloc>
+    void SortedList<T, Backend, Alloc>::detachNode(Node* target) {
+        // Unlinks target without destroying it, after checking that it belongs to this list
+        if (target->owner != id) {
+            throw std::invalid_argument("Iterator does not point to a valid node");
+        }
+        // level 0 is unlinked through the back link, so only a taller node searches for the
+        // predecessors on its upper levels
+        Node* update[MAX_LEVEL] = {};
+        if (target->height > 1 && !findPredecessors(target, update)) {
+            throw std::invalid_argument("Iterator does not point to a valid node");
+        }
+        unlinkNode(target, update);
+    }
+
+    template <class T, class Backend, class Alloc>
+    void SortedList<T, Backend, Alloc>::remove(const SortedList::ConstIterator &it) {
         if(it.node == nullptr){
             return;
         }
-        Node* current = Head;
+        detachNode(it.node);
+        destroyNode(it.node);
+    }
+
+    template <class T, class Backend, class Alloc>
+    template <typename Operation>
+    void SortedList<T, Backend, Alloc>::modify(const ConstIterator& it, Operation op) {
+        if (it.node == nullptr) {
+            throw std::invalid_argument("Iterator does not point to a valid node");
+        }
+        // Move the node itself to its new position instead of allocating a new one
+        detachNode(it.node);
+        try {
+            op(it.node->data);
+        } catch (...) {
+            linkNode(it.node);
+            throw;
+        }
+        linkNode(it.node);
+    }
+
+    template <class T, class Backend, class Alloc>
+    typename SortedList<T, Backend, Alloc>::ConstIterator SortedList<T, Backend, Alloc>::find(const T& key) const {
+        // Skip-list search for the first node that is not greater than key
         Node* prev = nullptr;
+        for (int lvl = level - 1; lvl >= 0; --lvl) {
+            Node* next = prev ? prev->next[lvl] : Head[lvl];
+            while (next && next->data > key) {
+                prev = next;
+                next = next->next[lvl];
+            }
+        }
+        Node* candidate = prev ? prev->next[0] : Head[0];
+        if (candidate && !(key > candidate->data)) {
+            return ConstIterator(candidate);
+        }
+        return end();
+    }
+
+    template <class T, class Backend, class Alloc>
+    const void* SortedList<T, Backend, Alloc>::handle(const ConstIterator& it) const {
+        return it.node;
+    }
 
-        while (current && current != it.node) {
-            prev = current;
-            current = current->next;
+    template <class T, class Backend, class Alloc>
+    typename SortedList<T, Backend, Alloc>::ConstIterator SortedList<T, Backend, Alloc>::at(const void* handle) const {
+        Node* node = static_cast<Node*>(const_cast<void*>(handle));
+        if (node == nullptr || node->owner != id) {
+            throw std::invalid_argument("Handle does not point to a valid node");
         }
+        return ConstIterator(node);
+    }
 
-        if (current == it.node) {
-            if (prev) {
-                prev->next = current->next;
-            } else {
-                Head = current->next;
+    template <class T, class Backend, class Alloc>
+    const T& SortedList<T, Backend, Alloc>::front() const {
+        if (Head[0] == nullptr) {
+            throw std::out_of_range("Accessing the front of an empty list");
+        }
+        return Head[0]->data;
+    }
+
+    template <class T, class Backend, class Alloc>
+    void SortedList<T, Backend, Alloc>::pop_front() {
+        Node* target = Head[0];
+        if (target == nullptr) {
+            throw std::out_of_range("Removing from an empty list");
+        }
+        // the first node is the first one on every level it reaches, so the heads are its predecessors
+        Node* const update[MAX_LEVEL] = {};
+        unlinkNode(target, update);
+        destroyNode(target);
+    }
+
+    template <class T, class Backend, class Alloc>
+    typename SortedList<T, Backend, Alloc>::Node* SortedList<T, Backend, Alloc>::lastNode() const {
+        // run to the end of every level from the top down, O(log n) like a search
+        Node* last = nullptr;
+        for (int lvl = level - 1; lvl >= 0; --lvl) {
+            Node* next = last ? last->next[lvl] : Head[lvl];
+            while (next) {
+                last = next;
+                next = next->next[lvl];
             }
-            delete current;
-        } else {
-            throw std::invalid_argument("Iterator does not point to a valid node");
         }
+        return last;
     }
 
-    template <class T>
-    int SortedList<T>::length() const {
-        int count = 0;
-        Node* current = Head;
-        while (current) {
-            count++;
-            current = current->next;
+    template <class T, class Backend, class Alloc>
+    const T& SortedList<T, Backend, Alloc>::back() const {
+        if (Head[0] == nullptr) {
+            throw std::out_of_range("Accessing the back of an empty list");
         }
-        return count;
+        return lastNode()->data;
     }
 
-    template <class T>
-    template <typename Predicate>
-    SortedList<T> SortedList<T>::filter(Predicate predicate) const {
-        SortedList<T> result;
-        Node* current = Head;
-        while (current) {
-            if (predicate(current->data)) {
-                result.insert(current->data);
+    template <class T, class Backend, class Alloc>
+    void SortedList<T, Backend, Alloc>::pop_back() {
+        if (Head[0] == nullptr) {
+            throw std::out_of_range("Removing from an empty list");
+        }
+        Node* target = lastNode();
+        detachNode(target);
+        destroyNode(target);
+    }
+
+    template <class T, class Backend, class Alloc>
+    int SortedList<T, Backend, Alloc>::length() const {
+        return size;
+    }
+
+    template <class T, class Backend, class Alloc>
+    void SortedList<T, Backend, Alloc>::merge(const SortedList& other) {
+        merge(SortedList(other));
+    }
+
+    template <class T, class Backend, class Alloc>
+    void SortedList<T, Backend, Alloc>::merge(SortedList&& other) {
+        if (this != &other) {
+            mergeChain(other.detachAll());
+        }
+    }
+
+    template <class T, class Backend, class Alloc>
+    void SortedList<T, Backend, Alloc>::splice(SortedList& other) {
+        merge(std::move(other));
+    }
+
+    template <class T, class Backend, class Alloc>
+    void SortedList<T, Backend, Alloc>::splice(SortedList& other, const ConstIterator& first, const ConstIterator& last) {
+        if (this == &other) {
+            throw std::invalid_argument("Splicing a list into itself");
+        }
+        if (first.node == last.node) {
+            return;
+        }
+        if (first.node == nullptr || first.node->owner != other.id) {
+            throw std::invalid_argument("Iterator does not point to a valid node");
+        }
+        // last must be reachable from first in other, so [first, last) is a range of other
+        Node* runTail = first.node;
+        while (runTail->next[0] != last.node) {
+            runTail = runTail->next[0];
+            if (runTail == nullptr) {
+                throw std::invalid_argument("Iterator does not point to a valid node");
             }
-            current = current->next;
         }
-        return result;
+        // Cut [first, last) out of other's level 0, the cut run is still sorted
+        other.link(first.node->prev, 0) = last.node;
+        if (last.node) {
+            last.node->prev = first.node->prev;
+        }
+        runTail->next[0] = nullptr;
+        other.relink();
+        mergeChain(first.node);
     }
 
-    template <class T>
+    template <class T, class Backend, class Alloc>
+    typename SortedList<T, Backend, Alloc>::Node* SortedList<T, Backend, Alloc>::sortChain(Node* chain) {
+        // Stable bottom-up merge sort of a level 0 chain, merging runs of width 1, 2, 4, ...
+        if (chain == nullptr) {
+            return nullptr;
+        }
+        for (int width = 1;; width *= 2) {
+            Node* result = nullptr;
+            Node** resultTail = &result;
+            Node* rest = chain;
+            int merges = 0;
+            while (rest) {
+                merges++;
+                Node* left = rest;
+                int leftSize = 0;
+                while (rest && leftSize < width) {
+                    rest = rest->next[0];
+                    leftSize++;
+                }
+                Node* right = rest;
+                int rightSize = 0;
+                while (rest && rightSize < width) {
+                    rest = rest->next[0];
+                    rightSize++;
+                }
+                // ties are taken from the left run, which keeps the sort stable
+                while (leftSize > 0 || rightSize > 0) {
+                    Node* taken;
+                    if (rightSize == 0 || (leftSize > 0 && !(right->data > left->data))) {
+                        taken = left;
+                        left = left->next[0];
+                        leftSize--;
+                    } else {
+                        taken = right;
+                        right = right->next[0];
+                        rightSize--;
+                    }
+                    *resultTail = taken;
+                    resultTail = &taken->next[0];
+                }
+            }
+            *resultTail = nullptr;
+            chain = result;
+            if (merges <= 1) {
+                return chain;
+            }
+        }
+    }
+
+    template <class T, class Backend, class Alloc>
     template <typename Operation>
-    SortedList<T> SortedList<T>::apply(Operation op) const {
-        SortedList<T> result;
-        Node* current = Head;
-        while (current) {
-            T data = op(current->data);
-            result.insert(data);
-            current = current->next;
+    void SortedList<T, Backend, Alloc>::transform(Operation op) {
+        // Modify the elements where they are, then fix the order only if op broke it
+        bool sorted = true;
+        for (Node* current = Head[0]; current; current = current->next[0]) {
+            op(current->data);
+            if (current->prev && current->data > current->prev->data) {
+                sorted = false;
+            }
+        }
+        if (!sorted) {
+            Node* chain = detachAll();
+            Head[0] = sortChain(chain);
+            relink();
+        }
+    }
+
+    template <class T, class Backend, class Alloc>
+    SortedList<T, Backend, Alloc> SortedList<T, Backend, Alloc>::split(const ConstIterator& position) {
+        SortedList result;
+        if (position.node == nullptr) {
+            return result;
+        }
+        if (position.node->owner != id) {
+            throw std::invalid_argument("Iterator does not point to a valid node");
         }
+        link(position.node->prev, 0) = nullptr;
+        result.Head[0] = position.node;
+        relink();
+        result.relink();
         return result;
     }
 
-    template <class T>
-    typename SortedList<T>::ConstIterator SortedList<T>::begin() const {
-        return ConstIterator(Head);
+    template <class T, class Backend, class Alloc>
+    template <typename Predicate>
+    SortedList<T, Backend, Alloc> SortedList<T, Backend, Alloc>::filter(Predicate predicate) const {
+        // filtering keeps the order, so the result is built by appending
+        return view().filter(predicate).template materialize<SortedList>();
+    }
+
+    template <class T, class Backend, class Alloc>
+    template <typename Operation>
+    SortedList<T, Backend, Alloc> SortedList<T, Backend, Alloc>::apply(Operation op) const {
+        // the results may come out of order, so they are sorted once
+        return view().apply(op).template materialize<SortedList>();
+    }
+
+    template <class T, class Backend, class Alloc>
+    ListView<SortedList<T, Backend, Alloc>> SortedList<T, Backend, Alloc>::view() const {
+        return ListView<SortedList>(*this);
     }
 
-    template <class T>
-    typename SortedList<T>::ConstIterator SortedList<T>::begin() {
-        return ConstIterator(Head);
+    template <class T, class Backend, class Alloc>
+    typename SortedList<T, Backend, Alloc>::ConstIterator SortedList<T, Backend, Alloc>::begin() const {
+        return ConstIterator(Head[0]);
     }
 
-    template <class T>
-    typename SortedList<T>::ConstIterator SortedList<T>::end() const {
+    template <class T, class Backend, class Alloc>
+    typename SortedList<T, Backend, Alloc>::ConstIterator SortedList<T, Backend, Alloc>::begin() {
+        return ConstIterator(Head[0]);
+    }
+
+    template <class T, class Backend, class Alloc>
+    typename SortedList<T, Backend, Alloc>::ConstIterator SortedList<T, Backend, Alloc>::end() const {
         return ConstIterator(nullptr);
     }
 
-    template <class T>
-    typename SortedList<T>::ConstIterator SortedList<T>::end() {
+    template <class T, class Backend, class Alloc>
+    typename SortedList<T, Backend, Alloc>::ConstIterator SortedList<T, Backend, Alloc>::end() {
         return ConstIterator(nullptr);
     }
 
-    template <typename T>
-    SortedList<T>::ConstIterator::ConstIterator(Node* node) : node(node) {}
+    template <class T, class Backend, class Alloc>
+    SortedList<T, Backend, Alloc>::ConstIterator::ConstIterator(Node* node) : node(node) {}
 
-    template <typename T>
-    const T& SortedList<T>::ConstIterator::operator*() const {
+    template <class T, class Backend, class Alloc>
+    const T& SortedList<T, Backend, Alloc>::ConstIterator::operator*() const {
         if (node == nullptr) {
             throw std::range_error("Dereferencing end iterator");
         } else {
@@ -223,19 +831,21 @@ namespace mtm {
         }
     }
 
-    template <typename T>
-    typename SortedList<T>::ConstIterator& SortedList<T>::ConstIterator::operator++() {
+    template <class T, class Backend, class Alloc>
+    typename SortedList<T, Backend, Alloc>::ConstIterator& SortedList<T, Backend, Alloc>::ConstIterator::operator++() {
         if (node == nullptr) {
             throw std::out_of_range("Incrementing end iterator");
         } else {
-            node = node->next;
+            node = node->next[0];
             return *this;
         }
     }
 
-    template <typename T>
-    bool SortedList<T>::ConstIterator::operator!=(const ConstIterator& other) const {
+    template <class T, class Backend, class Alloc>
+    bool SortedList<T, Backend, Alloc>::ConstIterator::operator!=(const ConstIterator& other) const {
         return node != other.node;
     }
 
-}
\ No newline at end of file
+}
+
+#include "ListView.h"
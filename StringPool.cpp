@@ -0,0 +1,109 @@
+#include "StringPool.h"
+#include <cstring>
+#include <functional>
+#include <new>
+
+namespace mtm {
+
+    // the strings a thread interned last, each holding a reference, looked up without a lock
+    struct ThreadCache {
+        static const std::size_t SLOTS = 256;
+
+        StringPool::Entry* slots[SLOTS] = {};
+
+        ~ThreadCache() {
+            for (StringPool::Entry* entry : slots) {
+                if (entry) {
+                    StringPool::global().release(entry);
+                }
+            }
+        }
+    };
+
+    namespace {
+
+        thread_local ThreadCache cache;
+
+    }
+
+    StringPool::Shard& StringPool::shardOf(std::size_t hash) {
+        // the low bits pick the cache slot, so the shard comes from higher ones
+        return shards[(hash >> 8) % SHARDS];
+    }
+
+    StringPool::Entry* StringPool::lookup(std::string_view text, std::size_t hash) {
+        Shard& shard = shardOf(hash);
+        std::lock_guard<std::mutex> guard(shard.lock);
+        auto found = shard.entries.find(text);
+        if (found != shard.entries.end()) {
+            found->second->refs.fetch_add(1, std::memory_order_relaxed);
+            return found->second;
+        }
+        // the characters follow the entry in the same block
+        void* block = ::operator new(sizeof(Entry) + text.size());
+        Entry* entry = new (block) Entry(hash, static_cast<std::uint32_t>(text.size()));
+        std::memcpy(const_cast<char*>(entry->chars()), text.data(), text.size());
+        try {
+            shard.entries.emplace(entry->view(), entry);
+        } catch (...) {
+            entry->~Entry();
+            ::operator delete(block);
+            throw;
+        }
+        return entry;
+    }
+
+    void StringPool::release(Entry* entry) {
+        int refs = entry->refs.load(std::memory_order_relaxed);
+        while (refs > 1) {
+            if (entry->refs.compare_exchange_weak(refs, refs - 1, std::memory_order_release, std::memory_order_relaxed)) {
+                return;
+            }
+        }
+        // the last reference is only dropped under the shard lock, where lookups take new ones
+        Shard& shard = shardOf(entry->hash);
+        std::lock_guard<std::mutex> guard(shard.lock);
+        if (entry->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            shard.entries.erase(entry->view());
+            entry->~Entry();
+            ::operator delete(static_cast<void*>(entry));
+        }
+    }
+
+    PooledString StringPool::intern(std::string_view text) {
+        if (text.empty()) {
+            return PooledString();
+        }
+        std::size_t hash = std::hash<std::string_view>()(text);
+        Entry*& slot = cache.slots[hash % ThreadCache::SLOTS];
+        if (slot && slot->hash == hash && slot->view() == text) {
+            // the cache holds a reference, so the entry cannot go away while this one is taken
+            slot->refs.fetch_add(1, std::memory_order_relaxed);
+            return PooledString(slot);
+        }
+        Entry* entry = lookup(text, hash);
+        entry->refs.fetch_add(1, std::memory_order_relaxed);
+        Entry* evicted = slot;
+        slot = entry;
+        if (evicted) {
+            release(evicted);
+        }
+        return PooledString(entry);
+    }
+
+    std::size_t StringPool::size() {
+        std::size_t count = 0;
+        for (Shard& shard : shards) {
+            std::lock_guard<std::mutex> guard(shard.lock);
+            count += shard.entries.size();
+        }
+        return count;
+    }
+
+    StringPool& StringPool::global() {
+        // intentionally leaked, thread caches may release strings after every static object is gone
+        static StringPool* pool = new StringPool();
+        return *pool;
+    }
+
+}
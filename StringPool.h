@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace mtm {
+
+    class PooledString;
+
+    /**
+     * @brief Interns strings, so that equal strings share one reference-counted copy.
+     *
+     * A string is freed as soon as the last PooledString referring to it is destroyed, so the pool
+     * holds only the strings in use. The table is split into shards with a lock each, and every
+     * thread keeps a small cache of the strings it interned last: interning a string that is in
+     * the cache takes no lock, so threads interning the same few descriptions do not contend.
+     *
+     * There is a single, process-wide pool.
+     */
+    class StringPool {
+    private:
+        struct Entry {
+            std::atomic<int> refs;
+            std::size_t hash;
+            std::uint32_t length;
+
+            Entry(std::size_t hash, std::uint32_t length) : refs(1), hash(hash), length(length) {}
+            const char* chars() const { return reinterpret_cast<const char*>(this + 1); }
+            std::string_view view() const { return std::string_view(chars(), length); }
+        };
+
+        struct alignas(64) Shard {
+            std::mutex lock;
+            std::unordered_map<std::string_view, Entry*> entries;
+        };
+
+        static const int SHARDS = 64;
+
+        Shard shards[SHARDS];
+
+        StringPool() = default;
+        Shard& shardOf(std::size_t hash);
+        Entry* lookup(std::string_view text, std::size_t hash);
+        void release(Entry* entry);
+
+        friend class PooledString;
+        friend struct ThreadCache;
+
+    public:
+        StringPool(const StringPool& other) = delete;
+        StringPool& operator=(const StringPool& other) = delete;
+
+        /**
+         * @brief Gets the pooled copy of a string, adding it if needed.
+         *
+         * @param text The string to intern.
+         * @return PooledString A reference to the pooled copy, which lives as long as a reference does.
+         */
+        PooledString intern(std::string_view text);
+
+        /**
+         * @brief Gets the number of distinct strings in the pool, including those held by thread caches.
+         */
+        std::size_t size();
+
+        /**
+         * @brief Gets the process-wide pool. It is never destroyed, so references never outlive it.
+         */
+        static StringPool& global();
+    };
+
+    /**
+     * @brief Reference to a string in the StringPool; copying it shares the string.
+     *
+     * The size of a pointer. The empty string needs no pooled copy and is a null reference.
+     */
+    class PooledString {
+    private:
+        StringPool::Entry* entry;
+
+        explicit PooledString(StringPool::Entry* entry) : entry(entry) {}
+        friend class StringPool;
+
+    public:
+        PooledString() noexcept : entry(nullptr) {}
+
+        PooledString(const PooledString& other) noexcept : entry(other.entry) {
+            if (entry) {
+                entry->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        PooledString(PooledString&& other) noexcept : entry(other.entry) {
+            other.entry = nullptr;
+        }
+
+        PooledString& operator=(const PooledString& other) noexcept {
+            PooledString copy(other);
+            std::swap(entry, copy.entry);
+            return *this;
+        }
+
+        PooledString& operator=(PooledString&& other) noexcept {
+            std::swap(entry, other.entry);
+            return *this;
+        }
+
+        ~PooledString() {
+            if (entry) {
+                StringPool::global().release(entry);
+            }
+        }
+
+        /**
+         * @brief Gets the string, valid as long as this reference or a copy of it exists.
+         */
+        std::string_view view() const {
+            return entry ? entry->view() : std::string_view();
+        }
+    };
+
+}
@@ -2,22 +2,13 @@
 #include "Task.h"
 
 // Constructor
-Task::Task(int priority, TaskType type, const string &desc)
-    : m_description(desc), m_priority(priority), m_type(type)
+Task::Task(int priority, TaskType type, std::string_view desc)
+    : m_description(mtm::StringPool::global().intern(desc)), m_id(0), m_priority(0), m_type(type)
 {
-    // enforce priority range of 0-100
-    // 0 is lowest priority, 100 is highest
-    if (m_priority < 0)
-    {
-        m_priority = 0;
-    }
-    else if (m_priority > 100)
-    {
-        m_priority = 100;
-    }
+    setPriority(priority);
 }
 
-Task::Task(int priority, const string &desc)
+Task::Task(int priority, std::string_view desc)
     : Task(priority, TaskType::General, desc) {}
 
 // Getters and setters
@@ -33,51 +24,49 @@ TaskType Task::getType() const {
     return m_type;
 }
 
-string Task::getDescription() const {
-    return m_description;
+std::string_view Task::getDescription() const {
+    return m_description.view();
 }
 
 int Task::getPriority() const {
     return m_priority;
 }
 
+void Task::setPriority(int newPriority) {
+    // enforce priority range of 0-100
+    // 0 is lowest priority, 100 is highest
+    if (newPriority < 0)
+    {
+        m_priority = 0;
+    }
+    else if (newPriority > 100)
+    {
+        m_priority = 100;
+    }
+    else
+    {
+        m_priority = static_cast<uint8_t>(newPriority);
+    }
+}
+
 
 // Overloaded operators
 ostream &operator<<(ostream& os, const Task& task) {
-    os << "Task ID: " << task.m_id << ", Priority: " << task.m_priority;
-    os << ", Type: " << taskTypeToString(task.m_type) << ", Description: " << task.m_description;
+    os << "Task ID: " << task.m_id << ", Priority: " << static_cast<int>(task.m_priority);
+    os << ", Type: " << taskTypeName(task.m_type) << ", Description: " << task.m_description.view();
     return os;
 }
 
 bool operator>(const Task& lhs, const Task& rhs) {
-    return lhs.m_priority > rhs.m_priority;
+    if (lhs.m_priority != rhs.m_priority) {
+        return lhs.m_priority > rhs.m_priority;
+    }
+    // equal priorities: the task assigned first (lower ID) comes first
+    return lhs.m_id < rhs.m_id;
 }
 
 
 // Convert TaskType to string
 std::string taskTypeToString(TaskType type) {
-    switch (type) {
-    case TaskType::Meeting:
-        return "Meeting";
-    case TaskType::Presentation:
-        return "Presentation";
-    case TaskType::Documentation:
-        return "Documentation";
-    case TaskType::Development:
-        return "Development";
-    case TaskType::Testing:
-        return "Testing";
-    case TaskType::Research:
-        return "Research";
-    case TaskType::Training:
-        return "Training";
-    case TaskType::Maintenance:
-        return "Maintenance";
-    case TaskType::CustomerSupport:
-        return "Customer Support";
-    case TaskType::General:
-        return "General";
-    default:
-        return "Unknown Task";
-    }
+    return string(taskTypeName(type));
 }
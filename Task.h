@@ -1,8 +1,11 @@
 
 #pragma once
 
+#include <cstdint>
 #include <iostream>
 #include <string>
+#include <string_view>
+#include "StringPool.h"
 
 using std::ostream;
 using std::string;
@@ -10,7 +13,7 @@ using std::string;
 /**
  * @brief Enum class representing different types of tasks.
  */
-enum class TaskType {
+enum class TaskType : uint8_t {
     Meeting,
     Presentation,
     Documentation,
@@ -23,6 +26,11 @@ enum class TaskType {
     General
 };
 
+/**
+ * @brief The number of TaskType values, for arrays indexed by type.
+ */
+const int TASK_TYPE_COUNT = static_cast<int>(TaskType::General) + 1;
+
 /**
  * @brief Converts a TaskType enum to its corresponding string representation.
  *
@@ -31,14 +39,33 @@ enum class TaskType {
  */
 string taskTypeToString(TaskType type);
 
+/**
+ * @brief Gets the name of a TaskType without allocating.
+ *
+ * @param type The TaskType whose name is wanted.
+ * @return std::string_view The same text as taskTypeToString, pointing into a static table.
+ */
+constexpr std::string_view taskTypeName(TaskType type) {
+    constexpr std::string_view NAMES[] = {
+        "Meeting", "Presentation", "Documentation", "Development", "Testing",
+        "Research", "Training", "Maintenance", "Customer Support", "General"
+    };
+    return static_cast<int>(type) < TASK_TYPE_COUNT ? NAMES[static_cast<int>(type)] : "Unknown Task";
+}
+
 /**
  * @brief Class representing a task.
+ *
+ * Kept small and cheap to copy: the priority and the type take a byte each, and the description
+ * is a reference to a copy interned in mtm::StringPool::global(), so copying a task never
+ * allocates and tasks with the same description share one copy of it. The copy is freed with the
+ * last task that refers to it.
  */
 class Task {
 private:
-    int m_id;
-    string m_description;
-    int m_priority;
+    mtm::PooledString m_description;
+    int32_t m_id;
+    uint8_t m_priority;
     TaskType m_type;
 
 public:
@@ -49,7 +76,7 @@ public:
      * @param type The type of the task (default is TaskType::General).
      * @param desc The description of the task (default is an empty string).
      */
-    Task(int priority, TaskType type = TaskType::General, const string& desc = "");
+    Task(int priority, TaskType type = TaskType::General, std::string_view desc = "");
 
     /**
      * @brief Constructor to create a Task object with a default type.
@@ -57,7 +84,7 @@ public:
      * @param priority The priority of the task, enforced to be in range [0, 100].
      * @param desc The description of the task.
      */
-    Task(int priority, const string& desc = "");
+    Task(int priority, std::string_view desc = "");
 
     /**
      * @brief Gets the ID of the task.
@@ -76,9 +103,9 @@ public:
     /**
      * @brief Gets the description of the task.
      *
-     * @return string The description of the task.
+     * @return std::string_view The description of the task, valid as long as this task or a copy of it exists.
      */
-    string getDescription() const;
+    std::string_view getDescription() const;
 
     /**
      * @brief Gets the priority of the task.
@@ -87,6 +114,13 @@ public:
      */
     int getPriority() const;
 
+    /**
+     * @brief Sets the priority of the task.
+     *
+     * @param newPriority The new priority, enforced to be in range [0, 100].
+     */
+    void setPriority(int newPriority);
+
     /**
      * @brief Gets the type of the task.
      *
@@ -106,10 +140,13 @@ public:
     /**
      * @brief Overloaded greater-than operator to compare two Task objects based on priority.
      *
+     * Tasks of equal priority are ordered by ID, so the task that was assigned first
+     * (the lower ID) is considered greater and comes first in a sorted list.
+     *
      * @param lhs The left-hand side Task object.
      * @param rhs The right-hand side Task object.
-     * @return true If the priority of lhs is greater than that of rhs.
-     * @return false If the priority of lhs is not greater than that of rhs.
+     * @return true If lhs has a higher priority than rhs, or the same priority and a lower ID.
+     * @return false Otherwise.
      */
     friend bool operator>(const Task& lhs, const Task& rhs);
 };
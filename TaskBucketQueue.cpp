@@ -0,0 +1,421 @@
+#include "TaskBucketQueue.h"
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+    int popCount(uint64_t bits) {
+#if defined(__GNUC__)
+        return __builtin_popcountll(bits);
+#else
+        int count = 0;
+        for (; bits; bits &= bits - 1) {
+            count++;
+        }
+        return count;
+#endif
+    }
+
+    int highestBit(uint64_t bits) {
+#if defined(__GNUC__)
+        return 63 - __builtin_clzll(bits);
+#else
+        int bit = 63;
+        while (!(bits >> bit)) {
+            bit--;
+        }
+        return bit;
+#endif
+    }
+
+    uint64_t bitsBelow(int bit) {
+        return bit >= 64 ? ~uint64_t(0) : (uint64_t(1) << bit) - 1;
+    }
+
+}
+
+// Constructors and assignment
+TaskBucketQueue::TaskBucketQueue() : m_occupied{0, 0}, m_size(0), m_seed(0x9E3779B9u) {}
+
+TaskBucketQueue::TaskBucketQueue(const TaskBucketQueue& other) : TaskBucketQueue() {
+    try {
+        for (const Task& task : other) {
+            insert(task);
+        }
+    } catch (...) {
+        clear();
+        throw;
+    }
+}
+
+TaskBucketQueue::TaskBucketQueue(TaskBucketQueue&& other) noexcept
+    : m_occupied{other.m_occupied[0], other.m_occupied[1]}, m_buckets(std::move(other.m_buckets)), m_size(other.m_size),
+      m_seed(other.m_seed) {
+    other.m_occupied[0] = other.m_occupied[1] = 0;
+    other.m_buckets.clear();
+    other.m_size = 0;
+}
+
+TaskBucketQueue& TaskBucketQueue::operator=(const TaskBucketQueue& other) {
+    if (this != &other) {
+        TaskBucketQueue temp(other);
+        *this = std::move(temp);
+    }
+    return *this;
+}
+
+TaskBucketQueue& TaskBucketQueue::operator=(TaskBucketQueue&& other) noexcept {
+    if (this != &other) {
+        clear();
+        m_occupied[0] = other.m_occupied[0];
+        m_occupied[1] = other.m_occupied[1];
+        m_buckets = std::move(other.m_buckets);
+        m_size = other.m_size;
+        other.m_occupied[0] = other.m_occupied[1] = 0;
+        other.m_buckets.clear();
+        other.m_size = 0;
+    }
+    return *this;
+}
+
+TaskBucketQueue::~TaskBucketQueue() {
+    clear();
+}
+
+// Bucket bookkeeping
+int TaskBucketQueue::heightOf(const Node* node) {
+    return node->tower ? node->tower->height : 1;
+}
+
+TaskBucketQueue::Node* TaskBucketQueue::successor(const Bucket& bucket, const Node* prev, int level) {
+    if (level == 0) {
+        return prev ? prev->next : bucket.head;
+    }
+    return prev ? prev->tower->next[level - 1] : bucket.heads[level - 1];
+}
+
+TaskBucketQueue::Node*& TaskBucketQueue::forward(Bucket& bucket, Node* prev, int level) {
+    if (level == 0) {
+        return prev ? prev->next : bucket.head;
+    }
+    return prev ? prev->tower->next[level - 1] : bucket.heads[level - 1];
+}
+
+TaskBucketQueue::Node*& TaskBucketQueue::last(Bucket& bucket, int level) {
+    return level == 0 ? bucket.tail : bucket.tails[level - 1];
+}
+
+void TaskBucketQueue::findPredecessors(const Bucket& bucket, const Node* target, bool linked, Node** update) {
+    // update[i] is the last node before target on level i, nullptr for the start of the bucket. On
+    // the levels a linked target is on, the search walks through any equal tasks until reaching it;
+    // a target that is not linked yet goes after the equal tasks, like an appended one.
+    int height = linked ? heightOf(target) : 0;
+    Node* prev = nullptr;
+    for (int level = LEVELS - 1; level >= 0; --level) {
+        Node* next = successor(bucket, prev, level);
+        if (level < height) {
+            while (next && next != target && !(target->data > next->data)) {
+                prev = next;
+                next = successor(bucket, prev, level);
+            }
+        } else {
+            while (next && !(target->data > next->data)) {
+                prev = next;
+                next = successor(bucket, prev, level);
+            }
+        }
+        update[level] = prev;
+    }
+}
+
+int TaskBucketQueue::bucketIndex(int priority) const {
+    if (priority < 64) {
+        return popCount(m_occupied[0] & bitsBelow(priority));
+    }
+    return popCount(m_occupied[0]) + popCount(m_occupied[1] & bitsBelow(priority - 64));
+}
+
+TaskBucketQueue::Bucket& TaskBucketQueue::bucketFor(int priority) {
+    int index = bucketIndex(priority);
+    uint64_t& word = m_occupied[priority / 64];
+    uint64_t bit = uint64_t(1) << (priority % 64);
+    if (!(word & bit)) {
+        m_buckets.insert(m_buckets.begin() + index, Bucket{priority, nullptr, nullptr, {}, {}});
+        word |= bit;
+    }
+    return m_buckets[index];
+}
+
+int TaskBucketQueue::randomHeight() {
+    int height = 1;
+    while (height < LEVELS) {
+        // xorshift32, two random bits per level give the 1/4 promotion probability
+        m_seed ^= m_seed << 13;
+        m_seed ^= m_seed >> 17;
+        m_seed ^= m_seed << 5;
+        if ((m_seed & 3) != 0) {
+            break;
+        }
+        height++;
+    }
+    return height;
+}
+
+void TaskBucketQueue::append(Node* node) {
+    Bucket& bucket = bucketFor(node->data.getPriority());
+    Node* update[LEVELS];
+    if (bucket.tail == nullptr || bucket.tail->data > node->data) {
+        // new tasks have the highest ID, so they follow the last node of every level
+        update[0] = bucket.tail;
+        for (int level = 1; level < LEVELS; ++level) {
+            update[level] = bucket.tails[level - 1];
+        }
+    } else {
+        // a moved task may belong further back
+        findPredecessors(bucket, node, false, update);
+    }
+    for (int level = 0; level < heightOf(node); ++level) {
+        Node*& link = forward(bucket, update[level], level);
+        Node* next = link;
+        forward(bucket, node, level) = next;
+        link = node;
+        if (next == nullptr) {
+            last(bucket, level) = node;
+        }
+    }
+    node->prev = update[0];
+    if (node->next) {
+        node->next->prev = node;
+    }
+    m_size++;
+}
+
+void TaskBucketQueue::unlink(Node* node) {
+    int priority = node->data.getPriority();
+    int index = bucketIndex(priority);
+    Bucket& bucket = m_buckets[index];
+    // level 0 is unlinked through the back link, so only a promoted node searches the bucket
+    int height = heightOf(node);
+    if (height > 1) {
+        Node* update[LEVELS];
+        findPredecessors(bucket, node, true, update);
+        for (int level = 1; level < height; ++level) {
+            Node* next = node->tower->next[level - 1];
+            forward(bucket, update[level], level) = next;
+            if (next == nullptr) {
+                bucket.tails[level - 1] = update[level];
+            }
+        }
+    }
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        bucket.head = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    } else {
+        bucket.tail = node->prev;
+    }
+    if (bucket.head == nullptr) {
+        m_buckets.erase(m_buckets.begin() + index);
+        m_occupied[priority / 64] &= ~(uint64_t(1) << (priority % 64));
+    }
+    m_size--;
+}
+
+TaskBucketQueue::Node* TaskBucketQueue::createNode(Task&& task) {
+    int height = randomHeight();
+    void* block = Alloc::allocate<Node>();
+    void* towerBlock = nullptr;
+    try {
+        if (height > 1) {
+            towerBlock = Alloc::allocate<Tower>();
+        }
+        Node* node = new (block) Node(std::move(task));
+        if (towerBlock) {
+            node->tower = new (towerBlock) Tower{height, {}};
+        }
+        return node;
+    } catch (...) {
+        if (towerBlock) {
+            Alloc::deallocate<Tower>(towerBlock);
+        }
+        Alloc::deallocate<Node>(block);
+        throw;
+    }
+}
+
+void TaskBucketQueue::destroyNode(Node* node) {
+    if (node->tower) {
+        Alloc::deallocate<Tower>(node->tower);
+    }
+    node->~Node();
+    Alloc::deallocate<Node>(node);
+}
+
+void TaskBucketQueue::clear() {
+    for (Bucket& bucket : m_buckets) {
+        Node* current = bucket.head;
+        while (current) {
+            Node* next = current->next;
+            destroyNode(current);
+            current = next;
+        }
+    }
+    m_buckets.clear();
+    m_occupied[0] = m_occupied[1] = 0;
+    m_size = 0;
+}
+
+// Queue operations
+TaskBucketQueue::ConstIterator TaskBucketQueue::begin() const {
+    if (m_buckets.empty()) {
+        return end();
+    }
+    int last = static_cast<int>(m_buckets.size()) - 1;
+    return ConstIterator(this, last, m_buckets[last].head);
+}
+
+TaskBucketQueue::ConstIterator TaskBucketQueue::end() const {
+    return ConstIterator(this, -1, nullptr);
+}
+
+TaskBucketQueue::ConstIterator TaskBucketQueue::insert(const Task& task) {
+    return insert(Task(task));
+}
+
+TaskBucketQueue::ConstIterator TaskBucketQueue::insert(Task&& task) {
+    Node* node = createNode(std::move(task));
+    try {
+        append(node);
+    } catch (...) {
+        destroyNode(node);
+        throw;
+    }
+    return ConstIterator(this, bucketIndex(node->data.getPriority()), node);
+}
+
+void TaskBucketQueue::remove(const ConstIterator& it) {
+    if (it.node == nullptr) {
+        return;
+    }
+    if (it.queue != this) {
+        throw std::invalid_argument("Iterator does not point to a valid node");
+    }
+    unlink(it.node);
+    destroyNode(it.node);
+}
+
+TaskBucketQueue::ConstIterator TaskBucketQueue::find(const Task& key) const {
+    int priority = key.getPriority();
+    if (!(m_occupied[priority / 64] & (uint64_t(1) << (priority % 64)))) {
+        return end();
+    }
+    int index = bucketIndex(priority);
+    const Bucket& bucket = m_buckets[index];
+    // the last node before key on every level, then one step on level 0
+    Node* prev = nullptr;
+    for (int level = LEVELS - 1; level >= 0; --level) {
+        Node* next = successor(bucket, prev, level);
+        while (next && next->data > key) {
+            prev = next;
+            next = successor(bucket, prev, level);
+        }
+    }
+    Node* current = successor(bucket, prev, 0);
+    if (current && !(key > current->data)) {
+        return ConstIterator(this, index, current);
+    }
+    return end();
+}
+
+const void* TaskBucketQueue::handle(const ConstIterator& it) const {
+    return it.node;
+}
+
+TaskBucketQueue::ConstIterator TaskBucketQueue::at(const void* handle) const {
+    if (handle == nullptr) {
+        throw std::invalid_argument("Handle does not point to a valid node");
+    }
+    Node* node = static_cast<Node*>(const_cast<void*>(handle));
+    return ConstIterator(this, bucketIndex(node->data.getPriority()), node);
+}
+
+const Task& TaskBucketQueue::front() const {
+    if (m_size == 0) {
+        throw std::out_of_range("Accessing the front of an empty list");
+    }
+    return m_buckets.back().head->data;
+}
+
+void TaskBucketQueue::pop_front() {
+    if (m_size == 0) {
+        throw std::out_of_range("Removing from an empty list");
+    }
+    Node* node = m_buckets.back().head;
+    unlink(node);
+    destroyNode(node);
+}
+
+const Task& TaskBucketQueue::back() const {
+    if (m_size == 0) {
+        throw std::out_of_range("Accessing the back of an empty list");
+    }
+    return m_buckets.front().tail->data;
+}
+
+void TaskBucketQueue::pop_back() {
+    if (m_size == 0) {
+        throw std::out_of_range("Removing from an empty list");
+    }
+    Node* node = m_buckets.front().tail;
+    unlink(node);
+    destroyNode(node);
+}
+
+int TaskBucketQueue::length() const {
+    return m_size;
+}
+
+int TaskBucketQueue::topPriority() const {
+    if (m_occupied[1]) {
+        return 64 + highestBit(m_occupied[1]);
+    }
+    if (m_occupied[0]) {
+        return highestBit(m_occupied[0]);
+    }
+    return -1;
+}
+
+mtm::ListView<TaskBucketQueue> TaskBucketQueue::view() const {
+    return mtm::ListView<TaskBucketQueue>(*this);
+}
+
+// Iterator
+TaskBucketQueue::ConstIterator::ConstIterator(const TaskBucketQueue* queue, int bucket, Node* node)
+    : queue(queue), bucket(bucket), node(node) {}
+
+const Task& TaskBucketQueue::ConstIterator::operator*() const {
+    if (node == nullptr) {
+        throw std::range_error("Dereferencing end iterator");
+    }
+    return node->data;
+}
+
+TaskBucketQueue::ConstIterator& TaskBucketQueue::ConstIterator::operator++() {
+    if (node == nullptr) {
+        throw std::out_of_range("Incrementing end iterator");
+    }
+    node = node->next;
+    if (node == nullptr) {
+        bucket--;
+        node = bucket >= 0 ? queue->m_buckets[bucket].head : nullptr;
+    }
+    return *this;
+}
+
+bool TaskBucketQueue::ConstIterator::operator!=(const ConstIterator& other) const {
+    return node != other.node;
+}
@@ -0,0 +1,250 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "Task.h"
+#include "SortedList.h"
+
+/**
+ * @brief Priority queue of tasks with one FIFO bucket per priority value.
+ *
+ * Task priorities are clamped to [0, 100], so the queue keeps a 128-bit occupancy bitmap and a
+ * bucket for every priority that currently holds tasks. Assigning appends to the tail of a bucket
+ * and completing pops the head of the highest bucket, both O(1) no matter how many tasks are
+ * queued. Tasks of equal priority come out in the order of their IDs, which is the order they were
+ * assigned in.
+ *
+ * Only occupied buckets are stored, ordered by priority; the bucket of priority p sits at the
+ * index given by the number of occupied priorities below p. An empty queue costs a few words.
+ *
+ * Within a bucket the tasks also form a skip list: one node in four is promoted to a tower of
+ * forward links on higher levels. A task that must go before the tail of its bucket, such as one
+ * whose priority changed, is placed by searching the levels in O(log n) instead of walking the
+ * bucket, and removing a promoted task finds its predecessors the same way. New tasks are still
+ * appended after the last node of every level in O(1).
+ *
+ * Offers the same surface as mtm::SortedList so it can be used as Person::TaskList.
+ */
+class TaskBucketQueue {
+public:
+    static const int PRIORITY_LEVELS = 101;
+
+private:
+    // levels of the skip list within a bucket, level 0 being the bucket's doubly linked list
+    static const int LEVELS = 8;
+
+    struct Node;
+
+    // the forward links of a node promoted above level 0, next[i] being the successor on level i+1
+    struct Tower {
+        int height;
+        Node* next[LEVELS - 1];
+    };
+
+    struct Node {
+        Task data;
+        Node* prev;
+        Node* next;
+        Tower* tower;
+        explicit Node(const Task& data) : data(data), prev(nullptr), next(nullptr), tower(nullptr) {}
+        explicit Node(Task&& data) : data(std::move(data)), prev(nullptr), next(nullptr), tower(nullptr) {}
+    };
+
+    struct Bucket {
+        int priority;
+        Node* head;
+        Node* tail;
+        // the first and last node on each level above 0
+        Node* heads[LEVELS - 1];
+        Node* tails[LEVELS - 1];
+    };
+
+    typedef mtm::PoolAllocator<> Alloc;
+
+    uint64_t m_occupied[2];
+    std::vector<Bucket> m_buckets;
+    int m_size;
+    unsigned int m_seed;
+
+    static int heightOf(const Node* node);
+    static Node* successor(const Bucket& bucket, const Node* prev, int level);
+    static Node*& forward(Bucket& bucket, Node* prev, int level);
+    static Node*& last(Bucket& bucket, int level);
+    static void findPredecessors(const Bucket& bucket, const Node* target, bool linked, Node** update);
+    int bucketIndex(int priority) const;
+    Bucket& bucketFor(int priority);
+    int randomHeight();
+    void append(Node* node);
+    void unlink(Node* node);
+    Node* createNode(Task&& task);
+    void destroyNode(Node* node);
+    void clear();
+
+public:
+    class ConstIterator;
+
+    TaskBucketQueue();
+    TaskBucketQueue(const TaskBucketQueue& other);
+    TaskBucketQueue(TaskBucketQueue&& other) noexcept;
+    template <typename InputIterator>
+    TaskBucketQueue(InputIterator first, InputIterator last);
+    template <typename InputIterator>
+    TaskBucketQueue(mtm::AlreadySorted, InputIterator first, InputIterator last);
+    TaskBucketQueue& operator=(const TaskBucketQueue& other);
+    TaskBucketQueue& operator=(TaskBucketQueue&& other) noexcept;
+    ~TaskBucketQueue();
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+    ConstIterator insert(const Task& task);
+    ConstIterator insert(Task&& task);
+    template <typename... Args>
+    void emplace(Args&&... args);
+    void remove(const ConstIterator& it);
+
+    /**
+     * @brief Applies op to the task at it and moves its node to the task's new position.
+     */
+    template <typename Operation>
+    void modify(const ConstIterator& it, Operation op);
+
+    /**
+     * @brief Finds the task with the same priority and ID as key, end() if there is none.
+     *
+     * Searches only the bucket of key's priority, in O(log n).
+     */
+    ConstIterator find(const Task& key) const;
+
+    /**
+     * @brief Gets a handle to the task at it, valid until the task is removed.
+     *
+     * The handle is the task's node, which modify, transform and moving the queue keep.
+     */
+    const void* handle(const ConstIterator& it) const;
+
+    /**
+     * @brief Gets an iterator to the task of a handle taken from this queue, in O(1).
+     */
+    ConstIterator at(const void* handle) const;
+
+    const Task& front() const;
+    void pop_front();
+    const Task& back() const;
+    void pop_back();
+    int length() const;
+
+    /**
+     * @brief Gets the highest priority currently queued, -1 if the queue is empty.
+     */
+    int topPriority() const;
+
+    mtm::ListView<TaskBucketQueue> view() const;
+    template<typename Predicate>
+    TaskBucketQueue filter(Predicate predicate) const;
+    template<typename Operation>
+    TaskBucketQueue apply(Operation op) const;
+
+    /**
+     * @brief Applies op to every task in place, moving the tasks whose priority changed.
+     *
+     * Reuses the existing nodes. The queue is re-bucketed in one linear pass, plus a stable sort
+     * only if op broke the order of the tasks.
+     */
+    template<typename Operation>
+    void transform(Operation op);
+};
+
+class TaskBucketQueue::ConstIterator {
+    const TaskBucketQueue* queue;
+    int bucket;
+    Node* node;
+    ConstIterator(const TaskBucketQueue* queue, int bucket, Node* node);
+    friend class TaskBucketQueue;
+
+public:
+    ConstIterator(const ConstIterator& other) = default;
+    ConstIterator& operator=(const ConstIterator& other) = default;
+    ~ConstIterator() = default;
+
+    const Task& operator*() const;
+    ConstIterator& operator++();
+    bool operator!=(const ConstIterator& other) const;
+};
+
+template <typename InputIterator>
+TaskBucketQueue::TaskBucketQueue(InputIterator first, InputIterator last) : TaskBucketQueue() {
+    for (; first != last; ++first) {
+        insert(*first);
+    }
+}
+
+template <typename InputIterator>
+TaskBucketQueue::TaskBucketQueue(mtm::AlreadySorted, InputIterator first, InputIterator last)
+    : TaskBucketQueue(first, last) {}
+
+template <typename... Args>
+void TaskBucketQueue::emplace(Args&&... args) {
+    insert(Task(std::forward<Args>(args)...));
+}
+
+template <typename Operation>
+void TaskBucketQueue::modify(const ConstIterator& it, Operation op) {
+    if (it.node == nullptr || it.queue != this) {
+        throw std::invalid_argument("Iterator does not point to a valid node");
+    }
+    unlink(it.node);
+    try {
+        op(it.node->data);
+    } catch (...) {
+        append(it.node);
+        throw;
+    }
+    append(it.node);
+}
+
+template <typename Predicate>
+TaskBucketQueue TaskBucketQueue::filter(Predicate predicate) const {
+    return view().filter(predicate).template materialize<TaskBucketQueue>();
+}
+
+template <typename Operation>
+TaskBucketQueue TaskBucketQueue::apply(Operation op) const {
+    return view().apply(op).template materialize<TaskBucketQueue>();
+}
+
+template <typename Operation>
+void TaskBucketQueue::transform(Operation op) {
+    // both allocations happen before anything is unlinked; with room for every bucket, appending
+    // the nodes back cannot throw, so no task is lost even if op throws
+    std::vector<Node*> nodes;
+    nodes.reserve(m_size);
+    m_buckets.reserve(PRIORITY_LEVELS);
+    for (int i = static_cast<int>(m_buckets.size()) - 1; i >= 0; --i) {
+        for (Node* current = m_buckets[i].head; current; current = current->next) {
+            nodes.push_back(current);
+        }
+    }
+    m_buckets.clear();
+    m_occupied[0] = m_occupied[1] = 0;
+    m_size = 0;
+    // appending from highest to lowest keeps every bucket in order
+    auto relink = [this, &nodes]() {
+        auto greater = [](const Node* lhs, const Node* rhs) { return lhs->data > rhs->data; };
+        if (!std::is_sorted(nodes.begin(), nodes.end(), greater)) {
+            std::stable_sort(nodes.begin(), nodes.end(), greater);
+        }
+        for (Node* node : nodes) {
+            append(node);
+        }
+    };
+    try {
+        for (Node* node : nodes) {
+            op(node->data);
+        }
+    } catch (...) {
+        relink();
+        throw;
+    }
+    relink();
+}
\ No newline at end of file
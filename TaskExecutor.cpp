@@ -0,0 +1,307 @@
+#include "TaskExecutor.h"
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+// Stats
+double ExecutorStats::throughput() const {
+
+    return seconds > 0 ? executed / seconds : 0;
+}
+
+double ExecutorStats::meanLatency(int priority) const {
+
+    if (priority < 0 || priority >= PRIORITY_LEVELS || countByPriority[priority] == 0) {
+
+        return 0;
+
+    }
+
+    return latencyByPriority[priority] / 1000.0 / countByPriority[priority];
+}
+
+// Executor
+TaskExecutor::Worker::Worker(int index) : queue("Worker " + std::to_string(index)), load(0) {}
+
+TaskExecutor::TaskExecutor(int workerCount)
+    : nextId(0), nextWorker(0), queued(0), unfinished(0), sleepers(0), stopping(false), started(Clock::now()) {
+
+    if (workerCount < 1) {
+
+        workerCount = 1;
+
+    }
+
+    for (int i = 0; i < workerCount; i++) {
+
+        workers.push_back(std::make_unique<Worker>(i));
+
+    }
+
+    // only once every worker exists, since any of them may be stolen from
+    for (std::unique_ptr<Worker> &worker : workers) {
+
+        worker->thread = std::thread(&TaskExecutor::run, this, std::ref(*worker));
+
+    }
+}
+
+TaskExecutor::~TaskExecutor() {
+
+    wait();
+
+    {
+        std::lock_guard<std::mutex> guard(idleLock);
+
+        stopping = true;
+    }
+
+    wakeUp.notify_all();
+
+    for (std::unique_ptr<Worker> &worker : workers) {
+
+        worker->thread.join();
+
+    }
+}
+
+int TaskExecutor::workerCount() const {
+
+    return static_cast<int>(workers.size());
+}
+
+int TaskExecutor::submit(const Task &task, Job job) {
+
+    return submit(static_cast<int>(nextWorker++ % workers.size()), task, std::move(job));
+}
+
+int TaskExecutor::submit(int worker, const Task &task, Job job) {
+
+    if (worker < 0 || worker >= workerCount()) {
+
+        throw std::invalid_argument("Error: Invalid worker index.");
+
+    }
+
+    Worker &target = *workers[worker];
+
+    Task newTask(task);
+
+    int id = nextId++;
+
+    newTask.setId(id);
+
+    unfinished++;
+
+    {
+        std::lock_guard<std::mutex> guard(target.lock);
+
+        target.jobs[id] = Pending{std::move(job), Clock::now()};
+
+        target.queue.assignTask(std::move(newTask));
+
+        target.load++;
+
+        queued++;
+    }
+
+    // a worker counts itself as a sleeper before it checks queued, so one of the two sides sees the other
+    if (sleepers > 0) {
+
+        { std::lock_guard<std::mutex> guard(idleLock); }
+
+        wakeUp.notify_one();
+
+    }
+
+    return id;
+}
+
+void TaskExecutor::wait() {
+
+    std::unique_lock<std::mutex> guard(idleLock);
+
+    allDone.wait(guard, [this]() { return unfinished == 0; });
+}
+
+ExecutorStats TaskExecutor::stats() const {
+
+    ExecutorStats total;
+
+    for (const std::unique_ptr<Worker> &worker : workers) {
+
+        std::lock_guard<std::mutex> guard(worker->lock);
+
+        total.executed += worker->stats.executed;
+
+        total.stolen += worker->stats.stolen;
+
+        total.failed += worker->stats.failed;
+
+        for (int priority = 0; priority < ExecutorStats::PRIORITY_LEVELS; priority++) {
+
+            total.countByPriority[priority] += worker->stats.countByPriority[priority];
+
+            total.latencyByPriority[priority] += worker->stats.latencyByPriority[priority];
+
+        }
+    }
+
+    total.seconds = std::chrono::duration<double>(Clock::now() - started).count();
+
+    return total;
+}
+
+// Workers
+bool TaskExecutor::takeOwn(Worker &self, Task &task, Pending &pending) {
+
+    std::lock_guard<std::mutex> guard(self.lock);
+
+    if (self.queue.taskCount() == 0) {
+
+        return false;
+
+    }
+
+    task = self.queue.getHighestPriorityTask();
+
+    self.queue.completeTask();
+
+    std::unordered_map<int, Pending>::iterator entry = self.jobs.find(task.getId());
+
+    pending = std::move(entry->second);
+
+    self.jobs.erase(entry);
+
+    self.load--;
+
+    queued--;
+
+    return true;
+}
+
+bool TaskExecutor::steal(Worker &self, Task &task, Pending &pending) {
+
+    Worker *victim = nullptr;
+
+    int most = 0;
+
+    for (std::unique_ptr<Worker> &worker : workers) {
+
+        int load = worker->load;
+
+        if (worker.get() != &self && load > most) {
+
+            victim = worker.get();
+
+            most = load;
+
+        }
+    }
+
+    if (victim == nullptr) {
+
+        return false;
+
+    }
+
+    // the tail, so the victim keeps the tasks it would run next
+    std::lock_guard<std::mutex> guard(victim->lock);
+
+    if (victim->queue.taskCount() == 0) {
+
+        return false;
+
+    }
+
+    task = victim->queue.getLowestPriorityTask();
+
+    victim->queue.removeLowestPriorityTask();
+
+    std::unordered_map<int, Pending>::iterator entry = victim->jobs.find(task.getId());
+
+    pending = std::move(entry->second);
+
+    victim->jobs.erase(entry);
+
+    victim->load--;
+
+    queued--;
+
+    return true;
+}
+
+void TaskExecutor::run(Worker &self) {
+
+    Task task(0, TaskType::General);
+
+    Pending pending;
+
+    while (true) {
+
+        bool stolen = false;
+
+        if (!takeOwn(self, task, pending)) {
+
+            stolen = steal(self, task, pending);
+
+            if (!stolen) {
+
+                std::unique_lock<std::mutex> guard(idleLock);
+
+                sleepers++;
+
+                wakeUp.wait(guard, [this]() { return stopping || queued > 0; });
+
+                sleepers--;
+
+                if (stopping && queued == 0) {
+
+                    return;
+
+                }
+
+                continue;
+
+            }
+        }
+
+        long long latency = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - pending.submitted).count();
+
+        bool failed = false;
+
+        try {
+
+            pending.job();
+
+        } catch (...) {
+
+            failed = true;
+
+        }
+
+        pending.job = nullptr;
+
+        {
+            std::lock_guard<std::mutex> guard(self.lock);
+
+            self.stats.executed++;
+
+            self.stats.stolen += stolen ? 1 : 0;
+
+            self.stats.failed += failed ? 1 : 0;
+
+            self.stats.countByPriority[task.getPriority()]++;
+
+            self.stats.latencyByPriority[task.getPriority()] += latency;
+        }
+
+        if (--unfinished == 0) {
+
+            { std::lock_guard<std::mutex> guard(idleLock); }
+
+            allDone.notify_all();
+
+        }
+    }
+}
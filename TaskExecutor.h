@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "Person.h"
+#include "Task.h"
+
+/**
+ * @brief Counters of a TaskExecutor, taken by TaskExecutor::stats().
+ */
+struct ExecutorStats {
+    static const int PRIORITY_LEVELS = 101;
+
+    long long executed = 0;
+    long long stolen = 0;
+    long long failed = 0;
+    double seconds = 0;
+    // per priority at execution time: the number of tasks run and their summed queueing delay
+    long long countByPriority[PRIORITY_LEVELS] = {};
+    long long latencyByPriority[PRIORITY_LEVELS] = {};
+
+    /**
+     * @brief Gets the number of tasks run per second since the executor started.
+     */
+    double throughput() const;
+
+    /**
+     * @brief Gets the mean time, in microseconds, the tasks of a priority waited before running.
+     */
+    double meanLatency(int priority) const;
+};
+
+/**
+ * @brief Pool of worker threads that run the jobs of tasks in priority order.
+ *
+ * Every worker owns a Person whose task list is its queue, and always runs its own highest
+ * priority task next. A worker whose queue is empty steals the lowest priority task of the most
+ * loaded worker, the one its owner would get to last. The jobs live in a table next to each queue,
+ * keyed by task ID, so tasks stay as small as the ones a TaskManager holds.
+ *
+ * A job that throws is counted as failed; the exception goes no further.
+ */
+class TaskExecutor {
+public:
+    typedef std::function<void()> Job;
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Pending {
+        Job job;
+        Clock::time_point submitted;
+    };
+
+    struct alignas(64) Worker {
+        std::mutex lock;
+        Person queue;
+        std::unordered_map<int, Pending> jobs;
+        // the length of queue, readable without the lock when looking for a victim
+        std::atomic<int> load;
+        ExecutorStats stats;
+        std::thread thread;
+
+        explicit Worker(int index);
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<int> nextId;
+    std::atomic<unsigned int> nextWorker;
+    // tasks submitted but not yet taken, and tasks submitted but not yet finished
+    std::atomic<int> queued;
+    std::atomic<int> unfinished;
+    std::atomic<int> sleepers;
+    std::atomic<bool> stopping;
+    std::mutex idleLock;
+    std::condition_variable wakeUp;
+    std::condition_variable allDone;
+    Clock::time_point started;
+
+    bool takeOwn(Worker &self, Task &task, Pending &pending);
+    bool steal(Worker &self, Task &task, Pending &pending);
+    void run(Worker &self);
+
+public:
+    /**
+     * @brief Constructor to create an executor and start its workers.
+     *
+     * @param workerCount The number of worker threads, at least 1.
+     */
+    explicit TaskExecutor(int workerCount = static_cast<int>(std::thread::hardware_concurrency()));
+
+    TaskExecutor(const TaskExecutor &other) = delete;
+    TaskExecutor &operator=(const TaskExecutor &other) = delete;
+
+    /**
+     * @brief Destructor that runs every queued task and stops the workers.
+     */
+    ~TaskExecutor();
+
+    /**
+     * @brief Gets the number of workers.
+     */
+    int workerCount() const;
+
+    /**
+     * @brief Queues a task on the workers in turn.
+     *
+     * @param task The task, whose priority orders it in the queue.
+     * @param job The work done when the task runs.
+     * @return int The ID given to the task.
+     */
+    int submit(const Task &task, Job job);
+
+    /**
+     * @brief Queues a task on a specific worker.
+     *
+     * @param worker The index of the worker.
+     * @param task The task, whose priority orders it in the queue.
+     * @param job The work done when the task runs.
+     * @return int The ID given to the task.
+     * @throws std::invalid_argument If there is no worker with this index.
+     */
+    int submit(int worker, const Task &task, Job job);
+
+    /**
+     * @brief Waits until every task submitted so far has run.
+     */
+    void wait();
+
+    /**
+     * @brief Gets the counters of all workers added up.
+     */
+    ExecutorStats stats() const;
+};
@@ -0,0 +1,228 @@
+#include "TaskIntake.h"
+#include <chrono>
+#include <memory>
+#include <utility>
+
+TaskIntake::Command::Command() : kind(BARRIER), task(0, TaskType::General), type(TaskType::General), amount(0) {}
+
+TaskIntake::TaskIntake(TaskManager &manager, size_t capacity, size_t batchSize)
+    : manager(manager), batchSize(batchSize > 0 ? batchSize : 1), queue(capacity), stopping(false),
+      failedCallbacks(0), applier(&TaskIntake::run, this) {}
+
+TaskIntake::~TaskIntake() {
+
+    stopping.store(true, std::memory_order_release);
+
+    applier.join();
+}
+
+// Producers
+void TaskIntake::submit(Command &&command) {
+
+    // a full ring is the only case in which a producer waits
+    while (!queue.tryPush(std::move(command))) {
+
+        std::this_thread::yield();
+
+    }
+}
+
+std::future<int> TaskIntake::assignTask(const string &personName, const Task &task) {
+
+    std::shared_ptr<std::promise<int>> promise = std::make_shared<std::promise<int>>();
+
+    std::future<int> result = promise->get_future();
+
+    assignTask(personName, task, [promise](int id, std::exception_ptr error) {
+
+        if (error) {
+
+            promise->set_exception(error);
+
+        } else {
+
+            promise->set_value(id);
+
+        }
+    });
+
+    return result;
+}
+
+void TaskIntake::assignTask(const string &personName, const Task &task, Completion done) {
+
+    Command command;
+
+    command.kind = Command::ASSIGN;
+
+    command.personName = personName;
+
+    command.task = task;
+
+    command.done = std::move(done);
+
+    submit(std::move(command));
+}
+
+void TaskIntake::completeTask(const string &personName, Completion done) {
+
+    Command command;
+
+    command.kind = Command::COMPLETE;
+
+    command.personName = personName;
+
+    command.done = std::move(done);
+
+    submit(std::move(command));
+}
+
+void TaskIntake::bumpPriorityByType(TaskType type, int priority, Completion done) {
+
+    Command command;
+
+    command.kind = Command::BUMP;
+
+    command.type = type;
+
+    command.amount = priority;
+
+    command.done = std::move(done);
+
+    submit(std::move(command));
+}
+
+void TaskIntake::flush() {
+
+    // commands are applied in queue order, so once this barrier is reached all earlier ones are too
+    std::shared_ptr<std::promise<void>> reached = std::make_shared<std::promise<void>>();
+
+    std::future<void> wait = reached->get_future();
+
+    Command command;
+
+    command.done = [reached](int, std::exception_ptr) { reached->set_value(); };
+
+    submit(std::move(command));
+
+    wait.get();
+}
+
+size_t TaskIntake::callbackFailures() const {
+
+    return failedCallbacks.load(std::memory_order_relaxed);
+}
+
+// Applier
+void TaskIntake::apply(Command &command) {
+
+    int id = -1;
+
+    std::exception_ptr error;
+
+    try {
+
+        switch (command.kind) {
+
+            case Command::ASSIGN:
+                id = manager.assignTask(command.personName, command.task);
+                break;
+
+            case Command::COMPLETE:
+                manager.completeTask(command.personName);
+                break;
+
+            case Command::BUMP:
+                manager.bumpPriorityByType(command.type, command.amount);
+                break;
+
+            case Command::BARRIER:
+                break;
+
+        }
+
+    } catch (...) {
+
+        error = std::current_exception();
+
+    }
+
+    if (command.done) {
+
+        // an exception escaping the applier thread would terminate the process
+        try {
+
+            command.done(id, error);
+
+        } catch (...) {
+
+            failedCallbacks.fetch_add(1, std::memory_order_relaxed);
+
+        }
+    }
+}
+
+size_t TaskIntake::drain(std::vector<Command> &batch) {
+
+    // taking the whole batch out first frees its cells for the producers before any work is done
+    Command command;
+
+    while (batch.size() < batchSize && queue.tryPop(command)) {
+
+        batch.push_back(std::move(command));
+
+    }
+
+    size_t count = batch.size();
+
+    for (Command &next : batch) {
+
+        apply(next);
+
+    }
+
+    batch.clear();
+
+    return count;
+}
+
+void TaskIntake::run() {
+
+    std::vector<Command> batch;
+
+    batch.reserve(batchSize);
+
+    int idle = 0;
+
+    while (true) {
+
+        if (drain(batch) > 0) {
+
+            idle = 0;
+
+            continue;
+
+        }
+
+        // once stopping is seen, every command queued before the destructor ran is in the ring
+        if (stopping.load(std::memory_order_acquire)) {
+
+            while (drain(batch) > 0) {
+            }
+
+            return;
+
+        }
+
+        // back off gradually, so a busy intake never sleeps and an idle one does not spin
+        if (++idle < 64) {
+
+            std::this_thread::yield();
+
+        } else {
+
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+
+        }
+    }
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+#include "MpmcQueue.h"
+#include "TaskManager.h"
+
+/**
+ * @brief Intake stage that lets any number of threads feed one TaskManager without locking it.
+ *
+ * Calls are queued as commands in a bounded lock-free ring and return at once; a dedicated applier
+ * thread drains the ring in batches and applies the commands to the manager in queue order, so
+ * the manager only ever sees a single writer. A producer only waits when the ring is full.
+ *
+ * Results come back through a future or a completion callback. Callbacks run on the applier
+ * thread and should be short; they must not call flush(). An exception thrown by a callback is
+ * dropped and counted, so it cannot stop the applier thread. While the intake exists, the manager
+ * must not be used directly from any other thread.
+ */
+class TaskIntake {
+public:
+    /**
+     * @brief Called once a command is applied, with the ID of the assigned task (-1 for other
+     * commands) and the exception the command threw, if any.
+     */
+    typedef std::function<void(int id, std::exception_ptr error)> Completion;
+
+private:
+    struct Command {
+        enum Kind { ASSIGN, COMPLETE, BUMP, BARRIER };
+
+        Kind kind;
+        string personName;
+        Task task;
+        TaskType type;
+        int amount;
+        Completion done;
+
+        Command();
+    };
+
+    TaskManager &manager;
+    size_t batchSize;
+    mtm::MpmcQueue<Command> queue;
+    std::atomic<bool> stopping;
+    std::atomic<size_t> failedCallbacks;
+    std::thread applier;
+
+    void submit(Command &&command);
+    void apply(Command &command);
+    size_t drain(std::vector<Command> &batch);
+    void run();
+
+public:
+    /**
+     * @brief Constructor to create an intake and start its applier thread.
+     *
+     * @param manager The manager the commands are applied to.
+     * @param capacity The number of commands the ring holds before producers have to wait.
+     * @param batchSize The most commands the applier takes out of the ring at once.
+     */
+    explicit TaskIntake(TaskManager &manager, size_t capacity = 4096, size_t batchSize = 64);
+
+    TaskIntake(const TaskIntake &other) = delete;
+    TaskIntake &operator=(const TaskIntake &other) = delete;
+
+    /**
+     * @brief Destructor that applies every queued command and stops the applier thread.
+     */
+    ~TaskIntake();
+
+    /**
+     * @brief Queues the assignment of a task to a person.
+     *
+     * @param personName The name of the person to whom the task will be assigned.
+     * @param task The task to be assigned.
+     * @return std::future<int> The ID given to the task, once it is assigned.
+     */
+    std::future<int> assignTask(const string &personName, const Task &task);
+
+    /**
+     * @brief Queues the assignment of a task to a person, reporting the task's ID to a callback.
+     *
+     * @param personName The name of the person to whom the task will be assigned.
+     * @param task The task to be assigned.
+     * @param done The callback receiving the ID given to the task.
+     */
+    void assignTask(const string &personName, const Task &task, Completion done);
+
+    /**
+     * @brief Queues the completion of the highest priority task of a person.
+     *
+     * @param personName The name of the person who will complete the task.
+     * @param done The callback told when the task is completed, or why it could not be.
+     */
+    void completeTask(const string &personName, Completion done = Completion());
+
+    /**
+     * @brief Queues a bump of the priority of all tasks of a specific type.
+     *
+     * @param type The type of tasks whose priority will be bumped.
+     * @param priority The amount by which the priority will be increased.
+     * @param done The callback told when the bump is applied, or why it could not be.
+     */
+    void bumpPriorityByType(TaskType type, int priority, Completion done = Completion());
+
+    /**
+     * @brief Waits until every command queued by this thread so far has been applied.
+     */
+    void flush();
+
+    /**
+     * @brief Gets the number of completion callbacks that threw, their exceptions dropped.
+     */
+    size_t callbackFailures() const;
+};
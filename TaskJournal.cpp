@@ -0,0 +1,420 @@
+#include "TaskJournal.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include "MappedFile.h"
+#include "TaskSnapshot.h"
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+    const char JOURNAL_MAGIC[8] = {'M', 'T', 'M', 'J', 'R', 'N', 'L', '\0'};
+    const uint32_t JOURNAL_VERSION = 2;
+
+    struct JournalHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+        uint64_t base;
+        uint64_t reserved;
+    };
+
+    // reads the fields of one record, failing instead of running past its block
+    class RecordReader {
+        const char *m_cursor;
+        const char *m_end;
+
+    public:
+        RecordReader(const char *begin, const char *end) : m_cursor(begin), m_end(end) {}
+
+        bool atEnd() const {
+            return m_cursor == m_end;
+        }
+
+        template <typename Field>
+        Field read() {
+            Field field;
+            if (static_cast<size_t>(m_end - m_cursor) < sizeof(field)) {
+                throw std::runtime_error("Error: The journal holds a malformed record.");
+            }
+            std::memcpy(&field, m_cursor, sizeof(field));
+            m_cursor += sizeof(field);
+            return field;
+        }
+
+        std::string_view readText() {
+            uint32_t length = read<uint32_t>();
+            if (static_cast<size_t>(m_end - m_cursor) < length) {
+                throw std::runtime_error("Error: The journal holds a malformed record.");
+            }
+            std::string_view text(m_cursor, length);
+            m_cursor += length;
+            return text;
+        }
+    };
+
+}
+
+// Opening and closing
+TaskJournal::TaskJournal(const std::string &path, uint64_t base, uint64_t keepBytes, int groupSize, int groupMillis)
+    : m_path(path), m_fd(-1), m_pending(0), m_writingCount(0), m_groupSize(groupSize > 0 ? groupSize : 1),
+      m_groupInterval(groupMillis > 0 ? groupMillis : 0), m_committedBytes(keepBytes), m_logged(0), m_synced(0),
+      m_syncRequested(false), m_busy(false), m_stopping(false) {
+#if defined(__unix__) || defined(__APPLE__)
+    m_fd = ::open(path.c_str(), O_WRONLY | O_CREAT, 0644);
+    if (m_fd < 0) {
+        throw std::runtime_error("Error: Cannot open the journal " + path + ".");
+    }
+    try {
+        if (keepBytes == 0) {
+            writeHeader(base);
+        } else if (::ftruncate(m_fd, static_cast<off_t>(keepBytes)) != 0 || ::lseek(m_fd, 0, SEEK_END) < 0) {
+            // drop a torn tail, so that new blocks follow the last valid one
+            throw std::runtime_error("Error: Cannot repair the journal " + path + ".");
+        }
+        m_committer = std::thread(&TaskJournal::runCommitter, this);
+    } catch (...) {
+        ::close(m_fd);
+        throw;
+    }
+#else
+    (void)base;
+    (void)keepBytes;
+    throw std::runtime_error("Error: Journals are not supported on this platform.");
+#endif
+}
+
+TaskJournal::~TaskJournal() {
+#if defined(__unix__) || defined(__APPLE__)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        // the committer writes what is left, retrying a failed block once; if that fails too, the
+        // records are lost as in a crash, since a destructor cannot report it
+        m_stopping = true;
+        m_failure.clear();
+    }
+    m_wake.notify_one();
+    m_committer.join();
+    ::close(m_fd);
+#endif
+}
+
+void TaskJournal::writeHeader(uint64_t base) {
+#if defined(__unix__) || defined(__APPLE__)
+    JournalHeader header = {};
+    std::memcpy(header.magic, JOURNAL_MAGIC, sizeof(header.magic));
+    header.version = JOURNAL_VERSION;
+    header.byteOrder = SNAPSHOT_BYTE_ORDER;
+    header.base = base;
+    if (::ftruncate(m_fd, 0) != 0 || ::lseek(m_fd, 0, SEEK_SET) < 0) {
+        throw std::runtime_error("Error: Cannot reset the journal " + m_path + ".");
+    }
+    writeAll(reinterpret_cast<const char *>(&header), sizeof(header));
+#if defined(__APPLE__)
+    ::fsync(m_fd);
+#else
+    ::fdatasync(m_fd);
+#endif
+    m_committedBytes = sizeof(header);
+#else
+    (void)base;
+#endif
+}
+
+void TaskJournal::writeAll(const char *data, size_t size) {
+#if defined(__unix__) || defined(__APPLE__)
+    while (size > 0) {
+        ssize_t written = ::write(m_fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Error: Writing the journal " + m_path + " failed.");
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+#else
+    (void)data;
+    (void)size;
+#endif
+}
+
+// Records
+void TaskJournal::put(const void *data, size_t size) {
+    const char *bytes = static_cast<const char *>(data);
+    m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+}
+
+void TaskJournal::beginRecord(RecordKind kind, size_t size) {
+    // the whole record is reserved up front, so that it is never left half written in the buffer
+    size_t needed = (m_buffer.empty() ? BLOCK_HEADER : m_buffer.size()) + 1 + size;
+    if (needed > m_buffer.capacity()) {
+        m_buffer.reserve(std::max(needed, m_buffer.capacity() * 2));
+    }
+    if (m_buffer.empty()) {
+        // room for the block header, filled in by the committer
+        m_buffer.resize(BLOCK_HEADER);
+    }
+    m_buffer.push_back(static_cast<char>(kind));
+}
+
+void TaskJournal::endRecord(std::unique_lock<std::mutex> &lock) {
+    m_logged++;
+    if (++m_pending == 1) {
+        // the committer times the group from its oldest record
+        m_oldestPending = std::chrono::steady_clock::now();
+        m_wake.notify_one();
+    } else if (m_pending == m_groupSize || m_buffer.size() >= MAX_BUFFERED) {
+        m_wake.notify_one();
+    }
+    // the only wait on the caller's thread: the disk has fallen a whole buffer behind
+    m_done.wait(lock, [this] { return m_buffer.size() < MAX_BUFFERED || !m_failure.empty(); });
+}
+
+void TaskJournal::addPerson(std::string_view name) {
+    std::unique_lock<std::mutex> lock(m_lock);
+    beginRecord(ADD_PERSON, sizeof(uint32_t) + name.size());
+    uint32_t length = static_cast<uint32_t>(name.size());
+    put(&length, sizeof(length));
+    put(name.data(), name.size());
+    endRecord(lock);
+}
+
+void TaskJournal::assignTask(int slot, const Task &task) {
+    std::unique_lock<std::mutex> lock(m_lock);
+    beginRecord(ASSIGN, sizeof(int32_t) + 2 + sizeof(uint32_t) + task.getDescription().size());
+    int32_t target = slot;
+    uint8_t fields[2] = {static_cast<uint8_t>(task.getPriority()), static_cast<uint8_t>(task.getType())};
+    uint32_t length = static_cast<uint32_t>(task.getDescription().size());
+    put(&target, sizeof(target));
+    put(fields, sizeof(fields));
+    put(&length, sizeof(length));
+    put(task.getDescription().data(), task.getDescription().size());
+    endRecord(lock);
+}
+
+void TaskJournal::completeTask(int slot) {
+    std::unique_lock<std::mutex> lock(m_lock);
+    beginRecord(COMPLETE, sizeof(int32_t));
+    int32_t target = slot;
+    put(&target, sizeof(target));
+    endRecord(lock);
+}
+
+void TaskJournal::bumpPriorityByType(TaskType type, int priorityBump) {
+    std::unique_lock<std::mutex> lock(m_lock);
+    beginRecord(BUMP, 1 + sizeof(int32_t));
+    uint8_t typeField = static_cast<uint8_t>(type);
+    int32_t amount = priorityBump;
+    put(&typeField, sizeof(typeField));
+    put(&amount, sizeof(amount));
+    endRecord(lock);
+}
+
+void TaskJournal::cancelTask(int id) {
+    std::unique_lock<std::mutex> lock(m_lock);
+    beginRecord(CANCEL, sizeof(int32_t));
+    int32_t target = id;
+    put(&target, sizeof(target));
+    endRecord(lock);
+}
+
+void TaskJournal::updatePriority(int id, int priority) {
+    std::unique_lock<std::mutex> lock(m_lock);
+    beginRecord(UPDATE, sizeof(int32_t) + 1);
+    int32_t target = id;
+    uint8_t priorityField = static_cast<uint8_t>(priority);
+    put(&target, sizeof(target));
+    put(&priorityField, sizeof(priorityField));
+    endRecord(lock);
+}
+
+// Commits
+void TaskJournal::writeBlock(std::vector<char> &block, int count) {
+    uint32_t size = static_cast<uint32_t>(block.size() - BLOCK_HEADER);
+    uint32_t records = static_cast<uint32_t>(count);
+    uint64_t checksum = snapshotChecksum(block.data() + BLOCK_HEADER, size);
+    std::memcpy(block.data(), &size, sizeof(size));
+    std::memcpy(block.data() + 4, &records, sizeof(records));
+    std::memcpy(block.data() + 8, &checksum, sizeof(checksum));
+#if defined(__unix__) || defined(__APPLE__)
+    try {
+        writeAll(block.data(), block.size());
+#if defined(__APPLE__)
+        if (::fsync(m_fd) != 0) {
+#else
+        if (::fdatasync(m_fd) != 0) {
+#endif
+            throw std::runtime_error("Error: Syncing the journal " + m_path + " failed.");
+        }
+    } catch (...) {
+        // cut off whatever part of the block reached the file, so that the retry follows the
+        // last synced block instead of a torn one, which replay would stop at
+        if (::ftruncate(m_fd, static_cast<off_t>(m_committedBytes)) != 0 ||
+            ::lseek(m_fd, static_cast<off_t>(m_committedBytes), SEEK_SET) < 0) {
+            throw std::runtime_error("Error: Cannot repair the journal " + m_path + ".");
+        }
+        throw;
+    }
+#endif
+    m_committedBytes += block.size();
+}
+
+void TaskJournal::runCommitter() {
+    std::unique_lock<std::mutex> lock(m_lock);
+    while (true) {
+        // wait for a full group, a group whose oldest record is due, a commit() or the destructor;
+        // after a failure, only the last two retry
+        while (!m_stopping && !m_syncRequested) {
+            if (m_failure.empty() && (m_pending >= m_groupSize || m_buffer.size() >= MAX_BUFFERED)) {
+                break;
+            }
+            if (m_pending == 0 || !m_failure.empty()) {
+                m_wake.wait(lock);
+            } else if (m_wake.wait_until(lock, m_oldestPending + m_groupInterval) == std::cv_status::timeout) {
+                break;
+            }
+        }
+        m_syncRequested = false;
+        if (m_pending == 0 && m_writingCount == 0) {
+            m_done.notify_all();
+            if (m_stopping) {
+                return;
+            }
+            continue;
+        }
+
+        // swap the buffers, so that records are logged into the other one while this one is written
+        if (m_writingCount == 0) {
+            std::swap(m_writing, m_buffer);
+        } else {
+            m_writing.insert(m_writing.end(), m_buffer.begin() + BLOCK_HEADER, m_buffer.end());
+        }
+        m_buffer.clear();
+        m_writingCount += m_pending;
+        m_pending = 0;
+        uint64_t logged = m_logged;
+        m_busy = true;
+        lock.unlock();
+
+        std::string failure;
+        try {
+            writeBlock(m_writing, m_writingCount);
+        } catch (const std::exception &error) {
+            failure = error.what();
+        }
+
+        lock.lock();
+        m_busy = false;
+        if (failure.empty()) {
+            m_writing.clear();
+            m_writingCount = 0;
+            m_synced = logged;
+        }
+        m_failure = failure;
+        m_done.notify_all();
+        if (m_stopping && !failure.empty()) {
+            return;
+        }
+    }
+}
+
+void TaskJournal::commit() {
+    std::unique_lock<std::mutex> lock(m_lock);
+    uint64_t logged = m_logged;
+    if (m_synced == logged) {
+        return;
+    }
+    // a failed block is retried once more before the failure is reported
+    m_failure.clear();
+    m_syncRequested = true;
+    m_wake.notify_one();
+    m_done.wait(lock, [this, logged] { return m_synced >= logged || !m_failure.empty(); });
+    if (m_synced < logged) {
+        throw std::runtime_error(m_failure);
+    }
+}
+
+void TaskJournal::restart(uint64_t base) {
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_done.wait(lock, [this] { return !m_busy; });
+    m_buffer.clear();
+    m_pending = 0;
+    m_writing.clear();
+    m_writingCount = 0;
+    m_failure.clear();
+    m_synced = m_logged;
+    writeHeader(base);
+}
+
+// Replay
+uint64_t TaskJournal::replay(const std::string &path, uint64_t base, const std::function<void(const Record &)> &apply) {
+    if (!std::ifstream(path)) {
+        return 0;
+    }
+    mtm::MappedFile file(path);
+    JournalHeader header;
+    if (file.size() < sizeof(header)) {
+        return 0;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, JOURNAL_MAGIC, sizeof(header.magic)) != 0 || header.version != JOURNAL_VERSION ||
+        header.byteOrder != SNAPSHOT_BYTE_ORDER || header.base != base) {
+        return 0;
+    }
+
+    uint64_t valid = sizeof(header);
+    while (file.size() - valid >= BLOCK_HEADER) {
+        const char *block = file.data() + valid;
+        uint32_t size;
+        uint64_t checksum;
+        std::memcpy(&size, block, sizeof(size));
+        std::memcpy(&checksum, block + 8, sizeof(checksum));
+        if (file.size() - valid - BLOCK_HEADER < size || snapshotChecksum(block + BLOCK_HEADER, size) != checksum) {
+            break;
+        }
+
+        RecordReader reader(block + BLOCK_HEADER, block + BLOCK_HEADER + size);
+        while (!reader.atEnd()) {
+            Record record = {};
+            record.kind = static_cast<RecordKind>(reader.read<uint8_t>());
+            switch (record.kind) {
+                case ADD_PERSON:
+                    record.text = reader.readText();
+                    break;
+                case ASSIGN:
+                    record.target = reader.read<int32_t>();
+                    record.priority = reader.read<uint8_t>();
+                    record.type = static_cast<TaskType>(reader.read<uint8_t>());
+                    record.text = reader.readText();
+                    break;
+                case COMPLETE:
+                case CANCEL:
+                    record.target = reader.read<int32_t>();
+                    break;
+                case BUMP:
+                    record.type = static_cast<TaskType>(reader.read<uint8_t>());
+                    record.priority = reader.read<int32_t>();
+                    break;
+                case UPDATE:
+                    record.target = reader.read<int32_t>();
+                    record.priority = reader.read<uint8_t>();
+                    break;
+                default:
+                    throw std::runtime_error("Error: The journal holds a malformed record.");
+            }
+            if (static_cast<int>(record.type) >= TASK_TYPE_COUNT) {
+                throw std::runtime_error("Error: The journal holds a malformed record.");
+            }
+            apply(record);
+        }
+        valid += BLOCK_HEADER + size;
+    }
+    return valid;
+}
@@ -1,150 +1,1384 @@
-#include "TaskManager.h"
-
-TaskManager::TaskManager() : numPersons(0), taskId(0) {
-
-    for (int i = 0; i < MAX_PERSONS; ++i) {
-
-        personsArray[i] = Person();
-
-    }
-}
-
-
-void TaskManager::assignTask(const std::string &personName, const Task &task) {
-
-    for (int i = 0; i < numPersons; i++) {
-
-        if (personsArray[i].getName() == personName) {
-
-            Task newTask(task.getPriority(), task.getType(), task.getDescription());
-
-            newTask.setId(taskId++);
-
-            personsArray[i].assignTask(newTask);
-
-            return;
-        }
-    }
-
-    if (numPersons >= MAX_PERSONS) {
-
-        throw std::runtime_error("Error: Maximum number of persons reached.");
-
-    }
-
-    personsArray[numPersons] = Person(personName);
-
-    Task newTask(task.getPriority(), task.getType(), task.getDescription());
-
-    newTask.setId(taskId++);
-
-    personsArray[numPersons].assignTask(newTask);
-
-    numPersons++;
-}
-
-void TaskManager::completeTask(const std::string &personName) {
-
-    for (int i = 0; i < numPersons; i++) {
-
-        if (personsArray[i].getName() == personName) {
-
-            personsArray[i].completeTask();
-
-            return;
-        }
-    }
-}
-
-void TaskManager::bumpPriorityByType(TaskType type, int priorityBump) {
-
-    if (priorityBump < 0) {
-
-        return;
-
-    }
-
-    for (int i = 0; i < numPersons; i++) {
-
-        SortedList<Task> tasks = personsArray[i].getTasks();
-
-        SortedList<Task> newTasks;
-
-        for (const Task& task : tasks) {
-
-            if (task.getType() == type) {
-
-                int newPriority = task.getPriority() + priorityBump;
-
-                Task updatedTask(newPriority, task.getType(), task.getDescription());
-
-                updatedTask.setId(task.getId());
-
-                newTasks.insert(updatedTask);
-
-            } else {
-
-                newTasks.insert(task);
-
-            }
-        }
-
-        personsArray[i].setTasks(newTasks);
-    }
-}
-
-void TaskManager::printAllEmployees() const {
-
-    for (int i = 0; i < numPersons; i++) {
-
-        std::cout << personsArray[i] << std::endl;
-
-    }
-}
-
-void TaskManager::printAllTasks() const {
-
-    SortedList<Task> allTasks;
-
-    for (int i = 0; i < numPersons; i++) {
-
-        const SortedList<Task> &tasks = personsArray[i].getTasks();
-
-        for (const Task &task : tasks) {
-
-            allTasks.insert(task);
-
-        }
-    }
-
-    for (const Task &task : allTasks) {
-
-        std::cout << task << std::endl;
-
-    }
-}
-
-void TaskManager::printTasksByType(TaskType type) const {
-
-    SortedList<Task> tasksByType;
-
-    for (int i = 0; i < numPersons; i++) {
-
-        const SortedList<Task> &tasks = personsArray[i].getTasks();
-
-        for (const Task &task : tasks) {
-
-            if (task.getType() == type) {
-
-                tasksByType.insert(task);
-
-            }
-        }
-    }
-
-    for (const Task &task : tasksByType) {
-
-        std::cout << task << std::endl;
-
-    }
-}
\ No newline at end of file
+#include "TaskManager.h"
+#include "MappedFile.h"
+#include "TaskSnapshot.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+    // a few chunks per thread, so that chunks of uneven cost even out
+    const int CHUNKS_PER_THREAD = 4;
+
+    // about how many tasks a printed chunk holds, so that the text formatted ahead stays small
+    const int CHUNK_TASKS = 1024;
+
+    // first item of a chunk when count items are split into chunks nearly equal parts
+    int chunkStart(int count, int chunks, int chunk) {
+        return static_cast<int>(static_cast<long long>(count) * chunk / chunks);
+    }
+
+    void appendBytes(std::vector<char> &out, const void *data, size_t size) {
+        const char *bytes = static_cast<const char *>(data);
+        out.insert(out.end(), bytes, bytes + size);
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    bool writeAll(int fd, const char *data, size_t size) {
+        while (size > 0) {
+            ssize_t written = ::write(fd, data, size);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+
+    // fsyncs the directory holding path, so that a rename into it is on disk
+    bool syncDirectory(const std::string &path) {
+        size_t slash = path.find_last_of('/');
+        std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+        int fd = ::open(directory.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        bool synced = ::fsync(fd) == 0;
+        ::close(fd);
+        return synced;
+    }
+#endif
+
+    // Replaces path with header followed by payload, so that a crash leaves either the old file or
+    // the whole new one. The bytes go to a temporary file that is fsynced before the rename, or the
+    // rename could reach the disk ahead of them; the directory is fsynced after it, or the rename
+    // itself could be lost.
+    void replaceFile(const std::string &path, const void *header, size_t headerSize, const std::vector<char> &payload) {
+        std::string temporary = path + ".tmp";
+#if defined(__unix__) || defined(__APPLE__)
+        int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            throw std::runtime_error("Error: Cannot write " + temporary + ".");
+        }
+        bool written = writeAll(fd, static_cast<const char *>(header), headerSize) &&
+                       writeAll(fd, payload.data(), payload.size()) && ::fsync(fd) == 0;
+        if (::close(fd) != 0 || !written) {
+            std::remove(temporary.c_str());
+            throw std::runtime_error("Error: Cannot write " + temporary + ".");
+        }
+#else
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            out.write(static_cast<const char *>(header), static_cast<std::streamsize>(headerSize));
+            out.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+            out.close();
+            if (!out) {
+                std::remove(temporary.c_str());
+                throw std::runtime_error("Error: Cannot write " + temporary + ".");
+            }
+        }
+#endif
+        if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+            std::remove(temporary.c_str());
+            throw std::runtime_error("Error: Cannot replace " + path + ".");
+        }
+#if defined(__unix__) || defined(__APPLE__)
+        if (!syncDirectory(path)) {
+            throw std::runtime_error("Error: Cannot sync the directory of " + path + ".");
+        }
+#endif
+    }
+
+    // records are copied out rather than cast in place, which would break strict aliasing
+    template <typename Record>
+    Record readRecord(const char *section, uint64_t index) {
+        Record record;
+        std::memcpy(&record, section + index * sizeof(Record), sizeof(Record));
+        return record;
+    }
+
+}
+
+TaskManager::TaskManager() : TaskManager(0, 1) {}
+
+TaskManager::TaskManager(int firstId, int idStride)
+    : firstId(firstId), taskId(firstId), idStride(idStride), typeOffsets{}, priorityCounts{}, taskStore(firstId, idStride),
+      snapshotBase(0) {}
+
+
+Person &TaskManager::personAt(PersonHandle person) {
+
+    if (person.id < 0 || person.id >= persons.size()) {
+
+        throw std::invalid_argument("Error: Invalid person handle.");
+
+    }
+
+    applyPendingBumps(person.id);
+
+    return persons[person.id];
+}
+
+void TaskManager::applyPendingBumps(int slot) const {
+
+    if (slot >= static_cast<int>(appliedOffsets.size())) {
+
+        // slots are dense, and a person added after a bump has no tasks to apply it to
+        appliedOffsets.resize(slot + 1, std::array<long long, TASK_TYPE_COUNT>{});
+
+    }
+
+    std::array<long long, TASK_TYPE_COUNT> &applied = appliedOffsets[slot];
+
+    for (int type = 0; type < TASK_TYPE_COUNT; type++) {
+
+        long long pending = typeOffsets[type] - applied[type];
+
+        if (pending == 0) {
+
+            continue;
+
+        }
+
+        // priorities never exceed 100, so a larger bump has the same effect as 100
+        int bump = pending > 100 ? 100 : static_cast<int>(pending);
+
+        persons[slot].bumpPriorityByType(static_cast<TaskType>(type), bump);
+
+        applied[type] = typeOffsets[type];
+
+    }
+}
+
+template <typename Work>
+void TaskManager::runChunks(int chunks, Work work) const {
+
+    // the executor would only count a throwing chunk as failed, so every chunk keeps its own error
+    std::vector<std::exception_ptr> errors(chunks);
+
+    try {
+
+        for (int chunk = 0; chunk < chunks; chunk++) {
+
+            executor->submit(Task(0, TaskType::General), [&work, &errors, chunk]() {
+
+                try {
+
+                    work(chunk);
+
+                } catch (...) {
+
+                    errors[chunk] = std::current_exception();
+
+                }
+            });
+        }
+
+    } catch (...) {
+
+        // the chunks already submitted refer to this frame
+        executor->wait();
+
+        throw;
+
+    }
+
+    executor->wait();
+
+    for (const std::exception_ptr &error : errors) {
+
+        if (error) {
+
+            std::rethrow_exception(error);
+
+        }
+    }
+}
+
+template <typename Work>
+void TaskManager::streamChunks(int chunks, Work work, OutputSink &sink) const {
+
+    // chunks are formatted in parallel and written in order as soon as they are done; at most
+    // window of them are formatted ahead, so the memory used does not grow with the output
+    int window = std::min(chunks, executor->workerCount() * 2);
+
+    std::vector<std::string> texts(window);
+
+    std::vector<std::future<void>> done(window);
+
+    auto submit = [&](int chunk) {
+
+        std::shared_ptr<std::promise<void>> finished = std::make_shared<std::promise<void>>();
+
+        done[chunk % window] = finished->get_future();
+
+        executor->submit(Task(0, TaskType::General), [&work, &texts, finished, chunk, window]() {
+
+            try {
+
+                std::string &text = texts[chunk % window];
+
+                text.clear();
+
+                StringSink textSink(text);
+
+                work(chunk, textSink);
+
+                finished->set_value();
+
+            } catch (...) {
+
+                finished->set_exception(std::current_exception());
+
+            }
+        });
+    };
+
+    try {
+
+        for (int chunk = 0; chunk < window; chunk++) {
+
+            submit(chunk);
+
+        }
+
+        for (int chunk = 0; chunk < chunks; chunk++) {
+
+            done[chunk % window].get();
+
+            const std::string &text = texts[chunk % window];
+
+            sink.write(text.data(), text.size());
+
+            if (chunk + window < chunks) {
+
+                submit(chunk + window);
+
+            }
+        }
+
+    } catch (...) {
+
+        // the chunks still queued refer to this frame
+        executor->wait();
+
+        throw;
+
+    }
+
+    sink.flush();
+}
+
+void TaskManager::applyAllPendingBumps() const {
+
+    if (!executor || persons.size() < 2) {
+
+        for (int i = 0; i < persons.size(); i++) {
+
+            applyPendingBumps(i);
+
+        }
+
+        return;
+
+    }
+
+    // grown up front, so that the chunks only touch their own slots
+    if (static_cast<int>(appliedOffsets.size()) < persons.size()) {
+
+        appliedOffsets.resize(persons.size(), std::array<long long, TASK_TYPE_COUNT>{});
+
+    }
+
+    int count = persons.size();
+
+    int chunks = std::min(count, executor->workerCount() * CHUNKS_PER_THREAD);
+
+    runChunks(chunks, [this, count, chunks](int chunk) {
+
+        for (int i = chunkStart(count, chunks, chunk); i < chunkStart(count, chunks, chunk + 1); i++) {
+
+            applyPendingBumps(i);
+
+        }
+    });
+}
+
+void TaskManager::setParallelism(int threadCount) {
+
+    if (threadCount > 1) {
+
+        executor = std::make_unique<TaskExecutor>(threadCount);
+
+    } else {
+
+        executor.reset();
+
+    }
+}
+
+PersonHandle TaskManager::getPersonHandle(const std::string &personName) {
+
+    int added = persons.size();
+
+    int slot = persons.findOrAdd(personName);
+
+    if (journal && slot == added) {
+
+        journal->addPerson(personName);
+
+    }
+
+    return PersonHandle(slot);
+}
+
+int TaskManager::assignTask(const std::string &personName, const Task &task) {
+
+    return assignTask(getPersonHandle(personName), task);
+}
+
+int TaskManager::assignTask(PersonHandle person, const Task &task) {
+
+    Person &assignee = personAt(person);
+
+    // copying a task is cheap, the description is shared through the string pool
+    Task newTask(task);
+
+    int id = taskId;
+
+    newTask.setId(id);
+
+    Task key(newTask.getPriority(), newTask.getType());
+
+    key.setId(id);
+
+    const void *handle = assignee.assignTask(newTask);
+
+    try {
+
+        taskStore.add(newTask, person.id, handle);
+
+    } catch (...) {
+
+        // the ID is not used up, so replaying the journal hands out the same IDs
+        assignee.cancelTask(key, handle);
+
+        throw;
+
+    }
+
+    taskId += idStride;
+
+    priorityCounts[static_cast<int>(key.getType())][key.getPriority()]++;
+
+    if (journal) {
+
+        journal->assignTask(person.id, task);
+
+    }
+
+    return id;
+}
+
+void TaskManager::completeTask(const std::string &personName) {
+
+    int slot = persons.find(personName);
+
+    if (slot < 0) {
+
+        return;
+
+    }
+
+    completeTask(PersonHandle(slot));
+}
+
+void TaskManager::completeTask(PersonHandle person) {
+
+    Person &assignee = personAt(person);
+
+    const Task &completed = assignee.getHighestPriorityTask();
+
+    int type = static_cast<int>(completed.getType());
+
+    int priority = completed.getPriority();
+
+    int id = assignee.completeTask();
+
+    priorityCounts[type][priority]--;
+
+    taskStore.remove(id);
+
+    if (journal) {
+
+        journal->completeTask(person.id);
+
+    }
+}
+
+void TaskManager::bumpPriorityByType(TaskType type, int priorityBump) {
+
+    if (priorityBump < 0) {
+
+        return;
+
+    }
+
+    // clamping composes for non-negative bumps, so successive bumps can be added up and applied later
+    typeOffsets[static_cast<int>(type)] += priorityBump;
+
+    taskStore.bumpPriority(type, priorityBump);
+
+    // the histogram is bumped right away, moving counts from the top down so none moves twice
+    int *counts = priorityCounts[static_cast<int>(type)];
+
+    for (int priority = PRIORITY_LEVELS - 2; priority >= 0 && priorityBump > 0; priority--) {
+
+        int bumped = priorityBump >= PRIORITY_LEVELS - 1 - priority ? PRIORITY_LEVELS - 1 : priority + priorityBump;
+
+        counts[bumped] += counts[priority];
+
+        counts[priority] = 0;
+
+    }
+
+    if (journal) {
+
+        journal->bumpPriorityByType(type, priorityBump);
+
+    }
+}
+
+Task TaskManager::taskKey(int id) const {
+
+    if (!taskStore.contains(id)) {
+
+        throw std::invalid_argument("Error: Invalid task id.");
+
+    }
+
+    applyPendingBumps(taskStore.owner(id));
+
+    Task key(taskStore.priority(id), taskStore.type(id));
+
+    key.setId(id);
+
+    return key;
+}
+
+const Task *TaskManager::findTask(int id) const {
+
+    if (!taskStore.contains(id)) {
+
+        return nullptr;
+
+    }
+
+    Task key = taskKey(id);
+
+    return persons[taskStore.owner(id)].findTask(key, taskStore.handle(id));
+}
+
+void TaskManager::cancelTask(int id) {
+
+    Task key = taskKey(id);
+
+    persons[taskStore.owner(id)].cancelTask(key, taskStore.handle(id));
+
+    priorityCounts[static_cast<int>(key.getType())][key.getPriority()]--;
+
+    taskStore.remove(id);
+
+    if (journal) {
+
+        journal->cancelTask(id);
+
+    }
+}
+
+void TaskManager::updatePriority(int id, int priority) {
+
+    Task key = taskKey(id);
+
+    Task updated(key);
+
+    updated.setPriority(priority);
+
+    // the task keeps its node, so its handle stays valid
+    persons[taskStore.owner(id)].setTaskPriority(key, updated.getPriority(), taskStore.handle(id));
+
+    int type = static_cast<int>(key.getType());
+
+    priorityCounts[type][key.getPriority()]--;
+
+    priorityCounts[type][updated.getPriority()]++;
+
+    taskStore.setPriority(id, updated.getPriority());
+
+    if (journal) {
+
+        journal->updatePriority(id, updated.getPriority());
+
+    }
+}
+
+std::vector<int> TaskManager::findTaskIds(TaskType type) const {
+
+    return taskStore.idsOfType(type);
+}
+
+std::vector<int> TaskManager::findTaskIds(int low, int high) const {
+
+    return taskStore.idsInPriorityRange(low, high);
+}
+
+const PersonRegistry &TaskManager::employees() const {
+
+    applyAllPendingBumps();
+
+    return persons;
+}
+
+void TaskManager::compact() {
+
+    applyAllPendingBumps();
+}
+
+void TaskManager::saveSnapshot(const std::string &path) const {
+
+    applyAllPendingBumps();
+
+    // the store keeps only the live tasks, in ID order, which is the order of the task records
+    std::vector<int> ids = taskStore.ids();
+
+    std::string strings;
+
+    std::vector<SnapshotPerson> personRecords(persons.size());
+
+    std::vector<SnapshotDescription> descriptionRecords;
+
+    std::unordered_map<std::string_view, uint32_t> descriptionIndex;
+
+    std::vector<SnapshotTask> taskRecords;
+
+    std::vector<uint32_t> listIndexes;
+
+    taskRecords.reserve(ids.size());
+
+    for (int id : ids) {
+
+        std::string_view description = taskStore.description(id);
+
+        std::unordered_map<std::string_view, uint32_t>::iterator found = descriptionIndex.find(description);
+
+        if (found == descriptionIndex.end()) {
+
+            found = descriptionIndex.emplace(description, static_cast<uint32_t>(descriptionRecords.size())).first;
+
+            descriptionRecords.push_back(SnapshotDescription{strings.size(), static_cast<uint32_t>(description.size()), 0});
+
+            strings.append(description);
+
+        }
+
+        taskRecords.push_back(SnapshotTask{id, taskStore.owner(id), found->second,
+                                           static_cast<uint8_t>(taskStore.priority(id)),
+                                           static_cast<uint8_t>(taskStore.type(id)), 0});
+    }
+
+    for (int i = 0; i < persons.size(); i++) {
+
+        SnapshotPerson &record = personRecords[i];
+
+        record = SnapshotPerson{strings.size(), static_cast<uint32_t>(persons[i].getName().size()), {}, 0};
+
+        strings.append(persons[i].getName());
+
+        for (int type = 0; type < TASK_TYPE_COUNT; type++) {
+
+            const Person::TaskList &list = persons[i].getTasks(static_cast<TaskType>(type));
+
+            record.taskCounts[type] = static_cast<uint32_t>(list.length());
+
+            for (const Task &task : list) {
+
+                // the records are in ID order, so a task's record is found by binary search
+                listIndexes.push_back(static_cast<uint32_t>(std::lower_bound(ids.begin(), ids.end(), task.getId()) - ids.begin()));
+
+            }
+        }
+    }
+
+    listIndexes.resize((listIndexes.size() + 1) / 2 * 2, 0);
+
+    std::vector<char> payload;
+
+    appendBytes(payload, personRecords.data(), personRecords.size() * sizeof(SnapshotPerson));
+
+    appendBytes(payload, descriptionRecords.data(), descriptionRecords.size() * sizeof(SnapshotDescription));
+
+    appendBytes(payload, taskRecords.data(), taskRecords.size() * sizeof(SnapshotTask));
+
+    appendBytes(payload, listIndexes.data(), listIndexes.size() * sizeof(uint32_t));
+
+    appendBytes(payload, strings.data(), strings.size());
+
+    SnapshotHeader header = {};
+
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+
+    header.version = SNAPSHOT_VERSION;
+
+    header.byteOrder = SNAPSHOT_BYTE_ORDER;
+
+    header.checksum = snapshotChecksum(payload.data(), payload.size());
+
+    header.payloadSize = payload.size();
+
+    header.nextTaskId = taskId;
+
+    header.idStride = idStride;
+
+    header.personCount = static_cast<uint32_t>(personRecords.size());
+
+    header.taskCount = static_cast<uint32_t>(taskRecords.size());
+
+    header.descriptionCount = static_cast<uint32_t>(descriptionRecords.size());
+
+    header.stringBytes = strings.size();
+
+    // The order matters for recovery: the snapshot is durable under its final name before the
+    // journal is restarted on top of it. Restarting first and crashing before the rename reached
+    // the disk would leave the old snapshot with a journal that no longer extends it.
+    replaceFile(path, &header, sizeof(header), payload);
+
+    // the changes logged so far are all in the snapshot now
+    snapshotBase = header.checksum;
+
+    if (journal) {
+
+        journal->restart(snapshotBase);
+
+    }
+}
+
+void TaskManager::loadSnapshot(const std::string &path) {
+
+    mtm::MappedFile file(path);
+
+    SnapshotHeader header;
+
+    if (file.size() < sizeof(header)) {
+
+        throw std::runtime_error("Error: " + path + " is not a task snapshot.");
+
+    }
+
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 || header.byteOrder != SNAPSHOT_BYTE_ORDER) {
+
+        throw std::runtime_error("Error: " + path + " is not a task snapshot.");
+
+    }
+
+    if (header.version != SNAPSHOT_VERSION) {
+
+        throw std::runtime_error("Error: " + path + " has an unsupported snapshot version.");
+
+    }
+
+    const uint64_t taskCount = header.taskCount;
+
+    const uint64_t sectionBytes = header.personCount * sizeof(SnapshotPerson) +
+                                  header.descriptionCount * sizeof(SnapshotDescription) + taskCount * sizeof(SnapshotTask) +
+                                  (taskCount + 1) / 2 * 2 * sizeof(uint32_t);
+
+    if (header.payloadSize != file.size() - sizeof(header) || header.stringBytes > header.payloadSize ||
+        sectionBytes != header.payloadSize - header.stringBytes) {
+
+        throw std::runtime_error("Error: " + path + " is truncated or corrupt.");
+
+    }
+
+    const char *personSection = file.data() + sizeof(header);
+
+    const char *descriptionSection = personSection + header.personCount * sizeof(SnapshotPerson);
+
+    const char *taskSection = descriptionSection + header.descriptionCount * sizeof(SnapshotDescription);
+
+    const char *listSection = taskSection + taskCount * sizeof(SnapshotTask);
+
+    const char *strings = file.data() + sizeof(header) + sectionBytes;
+
+    if (snapshotChecksum(personSection, header.payloadSize) != header.checksum) {
+
+        throw std::runtime_error("Error: " + path + " fails its checksum.");
+
+    }
+
+    std::runtime_error corrupt("Error: " + path + " is truncated or corrupt.");
+
+    if (header.idStride < 1 || header.nextTaskId < 0) {
+
+        throw corrupt;
+
+    }
+
+    // every description is interned once; a prototype per description, built with the type of its
+    // first task, then saves interning it again for each of its tasks
+    std::vector<std::string_view> descriptions(header.descriptionCount);
+
+    std::vector<int> prototypeOf(header.descriptionCount, -1);
+
+    std::vector<Task> prototypes;
+
+    for (uint32_t i = 0; i < header.descriptionCount; i++) {
+
+        SnapshotDescription record = readRecord<SnapshotDescription>(descriptionSection, i);
+
+        if (record.offset > header.stringBytes || record.length > header.stringBytes - record.offset) {
+
+            throw corrupt;
+
+        }
+
+        descriptions[i] = std::string_view(strings + record.offset, record.length);
+
+    }
+
+    int firstId = header.nextTaskId % header.idStride;
+
+    TaskStore loadedStore(firstId, header.idStride);
+
+    int loadedCounts[TASK_TYPE_COUNT][PRIORITY_LEVELS] = {};
+
+    std::vector<Task> tasks;
+
+    std::vector<int> owners;
+
+    tasks.reserve(taskCount);
+
+    owners.reserve(taskCount);
+
+    for (uint32_t i = 0; i < taskCount; i++) {
+
+        SnapshotTask record = readRecord<SnapshotTask>(taskSection, i);
+
+        bool idInOrder = tasks.empty() ? record.id >= firstId : record.id > tasks.back().getId();
+
+        if (!idInOrder || record.id >= header.nextTaskId || (record.id - firstId) % header.idStride != 0 ||
+            record.owner < 0 || static_cast<uint32_t>(record.owner) >= header.personCount || record.priority > 100 ||
+            record.type >= TASK_TYPE_COUNT || record.description >= header.descriptionCount) {
+
+            throw corrupt;
+
+        }
+
+        TaskType type = static_cast<TaskType>(record.type);
+
+        int &prototype = prototypeOf[record.description];
+
+        if (prototype < 0) {
+
+            prototype = static_cast<int>(prototypes.size());
+
+            prototypes.emplace_back(0, type, descriptions[record.description]);
+
+        }
+
+        Task task = prototypes[prototype].getType() == type ? prototypes[prototype]
+                                                              : Task(0, type, descriptions[record.description]);
+
+        task.setId(record.id);
+
+        task.setPriority(record.priority);
+
+        loadedStore.add(task, record.owner);
+
+        loadedCounts[record.type][record.priority]++;
+
+        tasks.push_back(task);
+
+        owners.push_back(record.owner);
+
+    }
+
+    // the lists were stored in priority order, so each one is built as is and only checked
+    PersonRegistry loadedPersons;
+
+    std::vector<bool> listed(taskCount, false);
+
+    std::vector<Task> buffer;
+
+    uint64_t cursor = 0;
+
+    for (uint32_t slot = 0; slot < header.personCount; slot++) {
+
+        SnapshotPerson record = readRecord<SnapshotPerson>(personSection, slot);
+
+        if (record.nameOffset > header.stringBytes || record.nameLength > header.stringBytes - record.nameOffset ||
+            loadedPersons.findOrAdd(string(strings + record.nameOffset, record.nameLength)) != static_cast<int>(slot)) {
+
+            throw corrupt;
+
+        }
+
+        for (int type = 0; type < TASK_TYPE_COUNT; type++) {
+
+            if (record.taskCounts[type] > taskCount - cursor) {
+
+                throw corrupt;
+
+            }
+
+            buffer.clear();
+
+            for (uint32_t k = 0; k < record.taskCounts[type]; k++) {
+
+                uint32_t index = readRecord<uint32_t>(listSection, cursor + k);
+
+                if (index >= taskCount || listed[index] || owners[index] != static_cast<int>(slot) ||
+                    static_cast<int>(tasks[index].getType()) != type || (!buffer.empty() && !(buffer.back() > tasks[index]))) {
+
+                    throw corrupt;
+
+                }
+
+                listed[index] = true;
+
+                buffer.push_back(tasks[index]);
+
+            }
+
+            cursor += record.taskCounts[type];
+
+            if (!buffer.empty()) {
+
+                loadedPersons[slot].setTasks(static_cast<TaskType>(type),
+                                             Person::TaskList(mtm::AlreadySorted(), buffer.begin(), buffer.end()));
+
+                // the nodes stay where they are as the list and the person are moved into place
+                const Person::TaskList &list = loadedPersons[slot].getTasks(static_cast<TaskType>(type));
+
+                for (Person::TaskList::ConstIterator it = list.begin(); it != list.end(); ++it) {
+
+                    loadedStore.setHandle((*it).getId(), list.handle(it));
+
+                }
+
+            }
+        }
+    }
+
+    if (cursor != taskCount) {
+
+        throw corrupt;
+
+    }
+
+    persons = std::move(loadedPersons);
+
+    taskStore = std::move(loadedStore);
+
+    this->firstId = firstId;
+
+    taskId = header.nextTaskId;
+
+    idStride = header.idStride;
+
+    std::memcpy(priorityCounts, loadedCounts, sizeof(priorityCounts));
+
+    std::fill(std::begin(typeOffsets), std::end(typeOffsets), 0);
+
+    appliedOffsets.clear();
+
+    snapshotBase = header.checksum;
+
+    if (journal) {
+
+        journal->restart(snapshotBase);
+
+    }
+}
+
+void TaskManager::openJournal(const std::string &path, int groupSize, int groupMillis) {
+
+    journal.reset();
+
+    journal = std::make_unique<TaskJournal>(path, snapshotBase, 0, groupSize, groupMillis);
+}
+
+void TaskManager::closeJournal() {
+
+    journal.reset();
+}
+
+void TaskManager::syncJournal() {
+
+    if (journal) {
+
+        journal->commit();
+
+    }
+}
+
+void TaskManager::recover(const std::string &snapshotPath, const std::string &journalPath, int groupSize,
+                          int groupMillis) {
+
+    journal.reset();
+
+    if (std::ifstream(snapshotPath)) {
+
+        loadSnapshot(snapshotPath);
+
+    } else {
+
+        // a journal without a snapshot holds every change since the manager was empty
+        persons = PersonRegistry();
+
+        taskStore = TaskStore(firstId, idStride);
+
+        taskId = firstId;
+
+        std::fill(std::begin(typeOffsets), std::end(typeOffsets), 0);
+
+        std::memset(priorityCounts, 0, sizeof(priorityCounts));
+
+        appliedOffsets.clear();
+
+        snapshotBase = 0;
+
+    }
+
+    // replayed changes go through the public methods, with no journal to log them again
+    uint64_t keepBytes = TaskJournal::replay(journalPath, snapshotBase,
+                                             [this](const TaskJournal::Record &record) { applyRecord(record); });
+
+    journal = std::make_unique<TaskJournal>(journalPath, snapshotBase, keepBytes, groupSize, groupMillis);
+}
+
+void TaskManager::applyRecord(const TaskJournal::Record &record) {
+
+    switch (record.kind) {
+
+        case TaskJournal::ADD_PERSON:
+            getPersonHandle(std::string(record.text));
+            break;
+
+        case TaskJournal::ASSIGN:
+            assignTask(PersonHandle(record.target), Task(record.priority, record.type, record.text));
+            break;
+
+        case TaskJournal::COMPLETE:
+            completeTask(PersonHandle(record.target));
+            break;
+
+        case TaskJournal::BUMP:
+            bumpPriorityByType(record.type, record.priority);
+            break;
+
+        case TaskJournal::CANCEL:
+            cancelTask(record.target);
+            break;
+
+        case TaskJournal::UPDATE:
+            updatePriority(record.target, record.priority);
+            break;
+
+    }
+}
+
+TaskManager::TaskRange TaskManager::tasks() const {
+
+    applyAllPendingBumps();
+
+    // every per-type list is already sorted, so merge them instead of sorting a copy
+    TaskRange allTasks;
+
+    for (int i = 0; i < persons.size(); i++) {
+
+        for (int type = 0; type < TASK_TYPE_COUNT; type++) {
+
+            const Person::TaskList &list = persons[i].getTasks(static_cast<TaskType>(type));
+
+            allTasks.add(list.begin(), list.end());
+
+        }
+    }
+
+    return allTasks;
+}
+
+TaskManager::TaskRange TaskManager::tasksByType(TaskType type) const {
+
+    applyAllPendingBumps();
+
+    TaskRange ofType;
+
+    for (int i = 0; i < persons.size(); i++) {
+
+        const Person::TaskList &list = persons[i].getTasks(type);
+
+        ofType.add(list.begin(), list.end());
+
+    }
+
+    return ofType;
+}
+
+std::vector<Task> TaskManager::topK(int k) const {
+
+    TaskRange allTasks = tasks();
+
+    std::vector<Task> result;
+
+    for (auto it = allTasks.begin(); static_cast<int>(result.size()) < k && it != allTasks.end(); ++it) {
+
+        result.push_back(*it);
+
+    }
+
+    return result;
+}
+
+std::vector<Task> TaskManager::topK(int k, TaskType type) const {
+
+    TaskRange ofType = tasksByType(type);
+
+    std::vector<Task> result;
+
+    for (auto it = ofType.begin(); static_cast<int>(result.size()) < k && it != ofType.end(); ++it) {
+
+        result.push_back(*it);
+
+    }
+
+    return result;
+}
+
+int TaskManager::countAbove(int priority) const {
+
+    int count = 0;
+
+    for (int type = 0; type < TASK_TYPE_COUNT; type++) {
+
+        for (int level = priority < 0 ? 0 : priority + 1; level < PRIORITY_LEVELS; level++) {
+
+            count += priorityCounts[type][level];
+
+        }
+    }
+
+    return count;
+}
+
+int TaskManager::kthHighest(int k) const {
+
+    if (k > 0) {
+
+        int seen = 0;
+
+        for (int priority = PRIORITY_LEVELS - 1; priority >= 0; priority--) {
+
+            for (int type = 0; type < TASK_TYPE_COUNT; type++) {
+
+                seen += priorityCounts[type][priority];
+
+            }
+
+            if (seen >= k) {
+
+                return priority;
+
+            }
+        }
+    }
+
+    throw std::out_of_range("Error: No task of this rank.");
+}
+
+void TaskManager::printAllEmployees() const {
+
+    OstreamSink sink(std::cout);
+
+    printAllEmployees(sink);
+}
+
+void TaskManager::printAllEmployees(OutputSink &sink) const {
+
+    if (executor && persons.size() > 1) {
+
+        applyAllPendingBumps();
+
+        // every chunk of persons, about CHUNK_TASKS tasks' worth, is formatted on its own
+        std::vector<int> starts(1, 0);
+
+        int tasksInChunk = 0;
+
+        for (int i = 0; i < persons.size(); i++) {
+
+            tasksInChunk += persons[i].taskCount() + 1;
+
+            if (tasksInChunk >= CHUNK_TASKS || i + 1 == persons.size()) {
+
+                starts.push_back(i + 1);
+
+                tasksInChunk = 0;
+
+            }
+        }
+
+        streamChunks(static_cast<int>(starts.size()) - 1, [this, &starts](int chunk, OutputSink &text) {
+
+            TaskWriter writer(text);
+
+            for (int i = starts[chunk]; i < starts[chunk + 1]; i++) {
+
+                writer.writePerson(persons[i]);
+
+                writer.write('\n');
+
+            }
+
+            writer.flush();
+        }, sink);
+
+        return;
+
+    }
+
+    TaskWriter writer(sink);
+
+    visitEmployees([&writer](const Person &person) {
+
+        writer.writePerson(person);
+
+        writer.write('\n');
+
+    });
+
+    writer.flush();
+}
+
+void TaskManager::printAllTasks() const {
+
+    OstreamSink sink(std::cout);
+
+    printAllTasks(sink);
+}
+
+void TaskManager::printAllTasks(OutputSink &sink) const {
+
+    if (executor) {
+
+        applyAllPendingBumps();
+
+        std::vector<const Person::TaskList *> lists;
+
+        std::array<int, PRIORITY_LEVELS> histogram{};
+
+        for (int i = 0; i < persons.size(); i++) {
+
+            for (int type = 0; type < TASK_TYPE_COUNT; type++) {
+
+                lists.push_back(&persons[i].getTasks(static_cast<TaskType>(type)));
+
+            }
+        }
+
+        for (int type = 0; type < TASK_TYPE_COUNT; type++) {
+
+            for (int priority = 0; priority < PRIORITY_LEVELS; priority++) {
+
+                histogram[priority] += priorityCounts[type][priority];
+
+            }
+        }
+
+        printMerged(lists, histogram, sink);
+
+        return;
+
+    }
+
+    TaskWriter writer(sink);
+
+    visitTasks([&writer](const Task &task) {
+
+        writer.writeTask(task);
+
+        writer.write('\n');
+
+    });
+
+    writer.flush();
+}
+
+void TaskManager::printTasksByType(TaskType type) const {
+
+    OstreamSink sink(std::cout);
+
+    printTasksByType(type, sink);
+}
+
+void TaskManager::printTasksByType(TaskType type, OutputSink &sink) const {
+
+    if (executor) {
+
+        applyAllPendingBumps();
+
+        std::vector<const Person::TaskList *> lists;
+
+        std::array<int, PRIORITY_LEVELS> histogram{};
+
+        for (int i = 0; i < persons.size(); i++) {
+
+            lists.push_back(&persons[i].getTasks(type));
+
+        }
+
+        for (int priority = 0; priority < PRIORITY_LEVELS; priority++) {
+
+            histogram[priority] = priorityCounts[static_cast<int>(type)][priority];
+
+        }
+
+        printMerged(lists, histogram, sink);
+
+        return;
+
+    }
+
+    TaskWriter writer(sink);
+
+    visitTasksByType(type, [&writer](const Task &task) {
+
+        writer.writeTask(task);
+
+        writer.write('\n');
+
+    });
+
+    writer.flush();
+}
+
+void TaskManager::printMerged(const std::vector<const Person::TaskList *> &lists,
+                              const std::array<int, PRIORITY_LEVELS> &histogram, OutputSink &sink) const {
+
+    typedef Person::TaskList::ConstIterator ListIterator;
+
+    // cut the priorities into bands of about equal task counts; no two tasks of one priority end up
+    // in different bands, so printing band after band gives the serial order
+    int total = 0;
+
+    for (int count : histogram) {
+
+        total += count;
+
+    }
+
+    if (total == 0) {
+
+        sink.flush();
+
+        return;
+
+    }
+
+    // enough bands to keep every thread busy and each band near CHUNK_TASKS tasks; a band never
+    // splits a priority, so a single very common priority still makes one large band
+    int wanted = std::min(total, std::max(executor->workerCount() * CHUNKS_PER_THREAD, total / CHUNK_TASKS));
+
+    // band b holds the priorities from floors[b] up to floors[b - 1] - 1
+    std::vector<int> floors;
+
+    int seen = 0;
+
+    for (int priority = PRIORITY_LEVELS - 1; priority > 0; priority--) {
+
+        seen += histogram[priority];
+
+        if (static_cast<long long>(seen) * wanted >= static_cast<long long>(total) * (static_cast<long long>(floors.size()) + 1)) {
+
+            floors.push_back(priority);
+
+        }
+    }
+
+    floors.push_back(0);
+
+    int bands = static_cast<int>(floors.size());
+
+    // where every band starts in every list, found with one pass over each list
+    std::vector<std::vector<ListIterator>> bounds(lists.size());
+
+    int listCount = static_cast<int>(lists.size());
+
+    int listChunks = std::max(1, std::min(listCount, executor->workerCount() * CHUNKS_PER_THREAD));
+
+    runChunks(listChunks, [&](int chunk) {
+
+        for (int l = chunkStart(listCount, listChunks, chunk); l < chunkStart(listCount, listChunks, chunk + 1); l++) {
+
+            ListIterator it = lists[l]->begin();
+
+            ListIterator end = lists[l]->end();
+
+            bounds[l].push_back(it);
+
+            for (int band = 0; band < bands; band++) {
+
+                while (it != end && (*it).getPriority() >= floors[band]) {
+
+                    ++it;
+
+                }
+
+                bounds[l].push_back(it);
+
+            }
+        }
+    });
+
+    streamChunks(bands, [&](int band, OutputSink &text) {
+
+        TaskRange inBand;
+
+        for (int l = 0; l < listCount; l++) {
+
+            inBand.add(bounds[l][band], bounds[l][band + 1]);
+
+        }
+
+        TaskWriter writer(text);
+
+        for (const Task &task : inBand) {
+
+            writer.writeTask(task);
+
+            writer.write('\n');
+
+        }
+
+        writer.flush();
+    }, sink);
+}
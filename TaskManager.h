@@ -3,28 +3,108 @@
 
 #include "Task.h"
 #include "Person.h"
+#include "PersonRegistry.h"
+#include "MergeIterator.h"
+#include "TaskStore.h"
+#include "TaskWriter.h"
 #include "SortedList.h"
+#include "TaskExecutor.h"
+#include "TaskJournal.h"
+#include <array>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <vector>
 
 /**
  * @brief Class managing tasks assigned to multiple persons.
  */
 class TaskManager {
 private:
+    static const int PRIORITY_LEVELS = 101;
+
     /**
-     * @brief Maximum number of persons the TaskManager can handle.
+     * @brief All persons, looked up by name through a hash table. Grows as persons are added.
+     *
+     * Mutable because pending bumps are applied lazily, also from const methods; applying them
+     * does not change what any method observes.
      */
-    static const int MAX_PERSONS = 10;
-
-    Person personsArray[MAX_PERSONS];
+    mutable PersonRegistry persons;
 
-    int numPersons;
+    /**
+     * @brief The first task ID handed out, where recovering without a snapshot starts again.
+     */
+    int firstId;
 
     int taskId;
+
+    /**
+     * @brief The distance between consecutive task IDs handed out by this manager.
+     */
+    int idStride;
+
+    /**
+     * @brief The total of all bumps issued so far for each task type.
+     */
+    long long typeOffsets[TASK_TYPE_COUNT];
+
+    /**
+     * @brief For every person slot, the part of typeOffsets already applied to its tasks.
+     */
+    mutable std::vector<std::array<long long, TASK_TYPE_COUNT>> appliedOffsets;
+
+    /**
+     * @brief The number of tasks of each type at each priority, pending bumps included.
+     */
+    int priorityCounts[TASK_TYPE_COUNT][PRIORITY_LEVELS];
+
+    /**
+     * @brief Every assigned task by ID, in columns: owner, priority, type and description.
+     */
+    TaskStore taskStore;
+
+    /**
+     * @brief The threads running the bulk operations, none in serial mode.
+     */
+    std::unique_ptr<TaskExecutor> executor;
+
+    /**
+     * @brief The journal every change is logged to, none if journaling is off.
+     */
+    std::unique_ptr<TaskJournal> journal;
+
+    /**
+     * @brief The checksum of the snapshot last saved or loaded, 0 if there is none.
+     */
+    mutable uint64_t snapshotBase;
+
+    Person &personAt(PersonHandle person);
+    void applyPendingBumps(int slot) const;
+    void applyAllPendingBumps() const;
+    Task taskKey(int id) const;
+    void applyRecord(const TaskJournal::Record &record);
+    template <typename Work>
+    void runChunks(int count, Work work) const;
+    template <typename Work>
+    void streamChunks(int count, Work work, OutputSink &sink) const;
+    void printMerged(const std::vector<const Person::TaskList *> &lists,
+                     const std::array<int, PRIORITY_LEVELS> &histogram, OutputSink &sink) const;
+
+    /**
+     * @brief Creates a manager handing out the task IDs firstId, firstId + idStride, ...
+     *
+     * Lets several managers share one ID space without sharing a counter.
+     */
+    TaskManager(int firstId, int idStride);
+    friend class ConcurrentTaskManager;
     // Note - Additional private fields and methods can be added if needed.
 
 public:
+    /**
+     * @brief Range over tasks, yielding const Task& from highest to lowest priority.
+     */
+    typedef mtm::MergeRange<Person::TaskList::ConstIterator> TaskRange;
+
     /**
      * @brief Default constructor to create a TaskManager object.
      *
@@ -42,13 +122,35 @@ public:
      */
     TaskManager &operator=(const TaskManager &other) = delete;
 
+    /**
+     * @brief Sets the number of threads the bulk operations run on.
+     *
+     * With more than one thread, folding pending bumps and printing split the persons, or the
+     * priorities, into chunks that are processed concurrently and then written out in order, so
+     * the output is exactly the serial one.
+     *
+     * @param threadCount The number of threads; 1, the default, runs everything on the calling thread.
+     */
+    void setParallelism(int threadCount);
+
     /**
      * @brief Assigns a task to a person.
      *
      * @param personName The name of the person to whom the task will be assigned.
      * @param task The task to be assigned.
+     * @return int The ID given to the task.
+     */
+    int assignTask(const string &personName, const Task &task);
+
+    /**
+     * @brief Assigns a task to a person identified by a handle.
+     *
+     * @param person The handle of the person to whom the task will be assigned.
+     * @param task The task to be assigned.
+     * @return int The ID given to the task.
+     * @throws std::invalid_argument If the handle is out of range for this TaskManager.
      */
-    void assignTask(const string &personName, const Task &task);
+    int assignTask(PersonHandle person, const Task &task);
 
     /**
      * @brief Completes the highest priority task assigned to a person.
@@ -57,19 +159,263 @@ public:
      */
     void completeTask(const string &personName);
 
+    /**
+     * @brief Completes the highest priority task assigned to a person identified by a handle.
+     *
+     * @param person The handle of the person who will complete the task.
+     * @throws std::invalid_argument If the handle is out of range for this TaskManager.
+     */
+    void completeTask(PersonHandle person);
+
+    /**
+     * @brief Gets the handle of a person, adding the person (with no tasks) if needed.
+     *
+     * @param personName The name of the person.
+     * @return PersonHandle A handle that stays valid for the lifetime of this TaskManager.
+     */
+    PersonHandle getPersonHandle(const string &personName);
+
     /**
      * @brief Bumps the priority of all tasks of a specific type.
      *
+     * The bump is O(1): it is recorded per type and applied to a person's tasks only the next
+     * time that person's tasks are assigned, completed or printed. Tasks assigned later are
+     * not affected by it.
+     *
      * @param type The type of tasks whose priority will be bumped.
      * @param priority The amount by which the priority will be increased.
      */
     void bumpPriorityByType(TaskType type, int priority);
 
+    /**
+     * @brief Finds a task by its ID.
+     *
+     * Looks the task up through an index from ID to person and type, then searches only that
+     * person's list of that type.
+     *
+     * @param id The ID of the task.
+     * @return const Task* The task, or nullptr if no task with this ID is assigned. Valid until
+     * the TaskManager is next modified.
+     */
+    const Task* findTask(int id) const;
+
+    /**
+     * @brief Removes a task, found by its ID, without completing the tasks before it.
+     *
+     * @param id The ID of the task.
+     * @throws std::invalid_argument If no task with this ID is assigned.
+     */
+    void cancelTask(int id);
+
+    /**
+     * @brief Changes the priority of a task, found by its ID.
+     *
+     * @param id The ID of the task.
+     * @param priority The new priority, enforced to be in range [0, 100].
+     * @throws std::invalid_argument If no task with this ID is assigned.
+     */
+    void updatePriority(int id, int priority);
+
+    /**
+     * @brief Gets the IDs of all the tasks of a type.
+     *
+     * Scans the type column of the task store, many tasks at a time.
+     *
+     * @param type The type of the tasks.
+     * @return std::vector<int> The IDs, in ascending order.
+     */
+    std::vector<int> findTaskIds(TaskType type) const;
+
+    /**
+     * @brief Gets the IDs of all the tasks with a priority in a range.
+     *
+     * Scans the priority column of the task store, many tasks at a time.
+     *
+     * @param low The lowest priority in the range.
+     * @param high The highest priority in the range.
+     * @return std::vector<int> The IDs, in ascending order.
+     */
+    std::vector<int> findTaskIds(int low, int high) const;
+
+    /**
+     * @brief Applies all pending bumps to the tasks they affect.
+     */
+    void compact();
+
+    /**
+     * @brief Writes all persons and tasks, and the next task ID, to a snapshot file.
+     *
+     * The snapshot is first written next to path and then renamed over it, so a failed save never
+     * leaves a partial file behind. TaskSnapshot.h describes the format.
+     *
+     * @param path The path of the snapshot.
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    void saveSnapshot(const string &path) const;
+
+    /**
+     * @brief Replaces all persons and tasks with those of a snapshot file.
+     *
+     * The file is memory-mapped and every task list is built in the order it was stored in,
+     * without sorting. If the file is not a valid snapshot, this manager is left unchanged.
+     *
+     * @param path The path of the snapshot.
+     * @throws std::runtime_error If the file cannot be read, or fails its version or checksum check.
+     */
+    void loadSnapshot(const string &path);
+
+    /**
+     * @brief Starts logging every change to a new journal, replacing any existing file.
+     *
+     * The journal holds the changes made on top of the last snapshot saved or loaded, so it should
+     * be opened right after one, or on an empty manager. Saving or loading a snapshot later empties
+     * it again.
+     *
+     * Every change is applied in full before it is logged, and a change that throws is not logged,
+     * so the journal never holds a change the manager does not. Logging only buffers the change; a
+     * background thread writes and syncs the buffered changes, so a failed write never interrupts
+     * a change and is reported by the next syncJournal() instead.
+     *
+     * @param path The path of the journal.
+     * @param groupSize The number of changes committed to disk together.
+     * @param groupMillis The longest time, in milliseconds, a change waits for the rest of its group.
+     * @throws std::runtime_error If the file cannot be written, or journals are not supported.
+     */
+    void openJournal(const string &path, int groupSize = 256, int groupMillis = 10);
+
+    /**
+     * @brief Commits the changes not yet on disk and stops journaling.
+     */
+    void closeJournal();
+
+    /**
+     * @brief Waits until every change made so far is on disk, without waiting for its group to fill.
+     *
+     * @throws std::runtime_error If the journal cannot be written; the changes stay buffered and the
+     * next call tries again.
+     */
+    void syncJournal();
+
+    /**
+     * @brief Restores the state before a crash from a snapshot and the journal written after it.
+     *
+     * Loads the snapshot if it exists, replays the committed changes of the journal on top of it
+     * and then keeps journaling to the same file. Without a snapshot the manager is first reset to
+     * empty, as it was when the journal was started. A journal written after another snapshot is
+     * ignored, and a group torn by the crash is dropped.
+     *
+     * @param snapshotPath The path of the snapshot, which need not exist.
+     * @param journalPath The path of the journal, which need not exist.
+     * @param groupSize The number of changes committed to disk together.
+     * @param groupMillis The longest time, in milliseconds, a change waits for the rest of its group.
+     * @throws std::runtime_error If the snapshot or the journal cannot be read or is corrupt.
+     */
+    void recover(const string &snapshotPath, const string &journalPath, int groupSize = 256, int groupMillis = 10);
+
+    /**
+     * @brief Gets the highest priority tasks of all employees.
+     *
+     * Merges the sorted task lists and stops after k tasks.
+     *
+     * @param k The number of tasks to return.
+     * @return std::vector<Task> Up to k tasks, from highest to lowest priority.
+     */
+    std::vector<Task> topK(int k) const;
+
+    /**
+     * @brief Gets the highest priority tasks of a specific type.
+     *
+     * @param k The number of tasks to return.
+     * @param type The type of the tasks.
+     * @return std::vector<Task> Up to k tasks of this type, from highest to lowest priority.
+     */
+    std::vector<Task> topK(int k, TaskType type) const;
+
+    /**
+     * @brief Counts the tasks of all employees with a priority higher than the given one.
+     *
+     * Answered from a per-priority histogram in O(1), without looking at the tasks.
+     *
+     * @param priority The priority to compare with.
+     * @return int The number of tasks with a higher priority.
+     */
+    int countAbove(int priority) const;
+
+    /**
+     * @brief Gets the priority of the k-th highest priority task of all employees.
+     *
+     * Answered from a per-priority histogram in O(1), without looking at the tasks.
+     *
+     * @param k The rank of the task, starting from 1.
+     * @return int The priority of the task.
+     * @throws std::out_of_range If there are fewer than k tasks or k is not positive.
+     */
+    int kthHighest(int k) const;
+
+    /**
+     * @brief Gets all tasks assigned to all employees, without copying them.
+     *
+     * Merges the employees' sorted task lists on the fly. The range and its iterators are valid
+     * until the TaskManager is next modified.
+     *
+     * @return TaskRange The tasks, from highest to lowest priority.
+     */
+    TaskRange tasks() const;
+
+    /**
+     * @brief Gets all tasks of a specific type, without copying them.
+     *
+     * @param type The type of the tasks.
+     * @return TaskRange The tasks, from highest to lowest priority. Valid until the TaskManager
+     * is next modified.
+     */
+    TaskRange tasksByType(TaskType type) const;
+
+    /**
+     * @brief Gets all employees, in the order they were added.
+     *
+     * @return const PersonRegistry& The employees, iterable as const Person&. Their task lists
+     * are up to date until the TaskManager is next modified.
+     */
+    const PersonRegistry &employees() const;
+
+    /**
+     * @brief Calls a visitor with every task, from highest to lowest priority.
+     *
+     * @param visit Called as visit(const Task&).
+     */
+    template <typename Visitor>
+    void visitTasks(Visitor &&visit) const;
+
+    /**
+     * @brief Calls a visitor with every task of a specific type, from highest to lowest priority.
+     *
+     * @param type The type of the tasks.
+     * @param visit Called as visit(const Task&).
+     */
+    template <typename Visitor>
+    void visitTasksByType(TaskType type, Visitor &&visit) const;
+
+    /**
+     * @brief Calls a visitor with every employee, in the order they were added.
+     *
+     * @param visit Called as visit(const Person&).
+     */
+    template <typename Visitor>
+    void visitEmployees(Visitor &&visit) const;
+
     /**
      * @brief Prints all employees and their tasks.
      */
     void printAllEmployees() const;
 
+    /**
+     * @brief Prints all employees and their tasks to a sink, flushing it once at the end.
+     *
+     * @param sink The sink receiving the text.
+     */
+    void printAllEmployees(OutputSink &sink) const;
+
     /**
      * @brief Prints all tasks of a specific type.
      *
@@ -77,8 +423,53 @@ public:
      */
     void printTasksByType(TaskType type) const;
 
+    /**
+     * @brief Prints all tasks of a specific type to a sink, flushing it once at the end.
+     *
+     * @param type The type of tasks to be printed.
+     * @param sink The sink receiving the text.
+     */
+    void printTasksByType(TaskType type, OutputSink &sink) const;
+
     /**
      * @brief Prints all tasks assigned to all employees.
      */
     void printAllTasks() const;
-};
\ No newline at end of file
+
+    /**
+     * @brief Prints all tasks assigned to all employees to a sink, flushing it once at the end.
+     *
+     * @param sink The sink receiving the text.
+     */
+    void printAllTasks(OutputSink &sink) const;
+};
+
+template <typename Visitor>
+void TaskManager::visitTasks(Visitor &&visit) const {
+
+    for (const Task &task : tasks()) {
+
+        visit(task);
+
+    }
+}
+
+template <typename Visitor>
+void TaskManager::visitTasksByType(TaskType type, Visitor &&visit) const {
+
+    for (const Task &task : tasksByType(type)) {
+
+        visit(task);
+
+    }
+}
+
+template <typename Visitor>
+void TaskManager::visitEmployees(Visitor &&visit) const {
+
+    for (const Person &person : employees()) {
+
+        visit(person);
+
+    }
+}
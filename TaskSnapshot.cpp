@@ -0,0 +1,74 @@
+#include "TaskSnapshot.h"
+#include <cstring>
+
+namespace {
+
+    const uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+    const uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+    const uint64_t PRIME3 = 0x165667B19E3779F9ULL;
+    const uint64_t PRIME4 = 0x85EBCA77C2B2AE63ULL;
+    const uint64_t PRIME5 = 0x27D4EB2F165667C5ULL;
+
+    uint64_t rotate(uint64_t value, int bits) {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    uint64_t load64(const char* data) {
+        uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        return word;
+    }
+
+    uint32_t load32(const char* data) {
+        uint32_t word;
+        std::memcpy(&word, data, sizeof(word));
+        return word;
+    }
+
+    uint64_t round(uint64_t lane, uint64_t word) {
+        return rotate(lane + word * PRIME2, 31) * PRIME1;
+    }
+
+    uint64_t mergeRound(uint64_t hash, uint64_t lane) {
+        return (hash ^ round(0, lane)) * PRIME1 + PRIME4;
+    }
+
+}
+
+uint64_t snapshotChecksum(const char* data, std::size_t size) {
+    const char* end = data + size;
+    uint64_t hash;
+    if (size >= 32) {
+        // four independent lanes over 32-byte stripes, which is where nearly all the bytes are
+        uint64_t lanes[4] = {PRIME1 + PRIME2, PRIME2, 0, 0 - PRIME1};
+        for (; data + 32 <= end; data += 32) {
+            for (int lane = 0; lane < 4; lane++) {
+                lanes[lane] = round(lanes[lane], load64(data + lane * 8));
+            }
+        }
+        hash = rotate(lanes[0], 1) + rotate(lanes[1], 7) + rotate(lanes[2], 12) + rotate(lanes[3], 18);
+        for (uint64_t lane : lanes) {
+            hash = mergeRound(hash, lane);
+        }
+    } else {
+        hash = PRIME5;
+    }
+    hash += size;
+    for (; data + 8 <= end; data += 8) {
+        hash = rotate(hash ^ round(0, load64(data)), 27) * PRIME1 + PRIME4;
+    }
+    if (data + 4 <= end) {
+        hash = rotate(hash ^ (load32(data) * PRIME1), 23) * PRIME2 + PRIME3;
+        data += 4;
+    }
+    for (; data < end; data++) {
+        hash = rotate(hash ^ (static_cast<unsigned char>(*data) * PRIME5), 11) * PRIME1;
+    }
+    // the avalanche spreads every input bit over the whole result
+    hash ^= hash >> 33;
+    hash *= PRIME2;
+    hash ^= hash >> 29;
+    hash *= PRIME3;
+    hash ^= hash >> 32;
+    return hash;
+}
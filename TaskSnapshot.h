@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "Task.h"
+
+/**
+ * @brief On-disk layout of a TaskManager snapshot, written by TaskManager::saveSnapshot.
+ *
+ * A SnapshotHeader is followed by the payload, whose sections come in this order:
+ *  - personCount SnapshotPerson records, in person slot order;
+ *  - descriptionCount SnapshotDescription records, each description stored once;
+ *  - taskCount SnapshotTask records, in ascending ID order;
+ *  - taskCount uint32_t indexes into the task records: the tasks of every person, type by type,
+ *    each type already in priority order, then padding to a multiple of 8 bytes;
+ *  - stringBytes bytes holding the person names and the descriptions.
+ *
+ * Integers are stored in the byte order of the machine that wrote the file, which byteOrder
+ * records. The checksum covers the whole payload.
+ */
+const char SNAPSHOT_MAGIC[8] = {'M', 'T', 'M', 'S', 'N', 'A', 'P', '\0'};
+const uint32_t SNAPSHOT_VERSION = 2;
+const uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t checksum;
+    uint64_t payloadSize;
+    int32_t nextTaskId;
+    int32_t idStride;
+    uint32_t personCount;
+    uint32_t taskCount;
+    uint32_t descriptionCount;
+    uint32_t reserved;
+    uint64_t stringBytes;
+};
+
+struct SnapshotPerson {
+    uint64_t nameOffset;
+    uint32_t nameLength;
+    uint32_t taskCounts[TASK_TYPE_COUNT];
+    uint32_t reserved;
+};
+
+struct SnapshotDescription {
+    uint64_t offset;
+    uint32_t length;
+    uint32_t reserved;
+};
+
+struct SnapshotTask {
+    int32_t id;
+    int32_t owner;
+    uint32_t description;
+    uint8_t priority;
+    uint8_t type;
+    uint16_t reserved;
+};
+
+static_assert(sizeof(SnapshotHeader) == 64, "snapshot header layout changed");
+static_assert(sizeof(SnapshotPerson) % 8 == 0, "snapshot person layout is not 8-byte aligned");
+static_assert(sizeof(SnapshotDescription) == 16, "snapshot description layout changed");
+static_assert(sizeof(SnapshotTask) == 16, "snapshot task layout changed");
+
+/**
+ * @brief xxHash64 of the bytes, with seed 0. Every input bit affects every bit of the result.
+ *
+ * @param data The bytes to checksum.
+ * @param size The number of bytes.
+ * @return uint64_t The checksum.
+ */
+uint64_t snapshotChecksum(const char* data, std::size_t size);
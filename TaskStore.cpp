@@ -0,0 +1,343 @@
+#include "TaskStore.h"
+#include <algorithm>
+
+#if defined(__AVX2__) || defined(__SSSE3__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+    const int MAX_PRIORITY = 100;
+
+    // the highest epoch a row can be stamped with
+    const size_t MAX_EPOCH = 0xFFFF;
+
+    // running bump totals are folded in before they come near overflowing
+    const int32_t MAX_BUMPED = 1 << 30;
+
+#if defined(__SSE2__)
+    // rows of a scanned block whose bit is set in mask, as ids
+    void collect(uint32_t mask, const int32_t* ids, std::vector<int>& out) {
+        while (mask) {
+            out.push_back(ids[__builtin_ctz(mask)]);
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+}
+
+// Constructor
+TaskStore::TaskStore(int firstId, int idStride)
+    : m_baseIndex(0), m_firstId(firstId), m_idStride(idStride), m_dead(0), m_bumped{}, m_epochStarts(1),
+      m_hasPending(false) {}
+
+// Row bookkeeping
+int TaskStore::indexOf(int id) const {
+    if (id < m_firstId || (id - m_firstId) % m_idStride != 0) {
+        return -1;
+    }
+    int index = (id - m_firstId) / m_idStride - m_baseIndex;
+    return index >= 0 && index < static_cast<int>(m_rows.size()) ? index : -1;
+}
+
+int TaskStore::rowOf(int id) const {
+    int index = indexOf(id);
+    return index < 0 ? -1 : m_rows[index];
+}
+
+int TaskStore::currentEpoch() {
+    if (m_bumped != m_epochStarts.back()) {
+        // bumps were issued since the last epoch began, so new rows need an epoch of their own;
+        // past a limit of one epoch per row the bumps are folded in, which amortizes to O(1)
+        if (m_epochStarts.size() > MAX_EPOCH || m_epochStarts.size() > m_ids.size() + 64) {
+            applyPending();
+        } else {
+            m_epochStarts.push_back(m_bumped);
+        }
+    }
+    return static_cast<int>(m_epochStarts.size()) - 1;
+}
+
+int TaskStore::pendingBump(int row) const {
+    int type = m_types[row];
+    int bump = m_bumped[type] - m_epochStarts[m_epochs[row]][type];
+    return bump > MAX_PRIORITY ? MAX_PRIORITY : bump;
+}
+
+void TaskStore::applyPending() const {
+    uint8_t* priorities = m_priorities.data();
+    const uint8_t* types = m_types.data();
+    size_t count = m_priorities.size();
+    size_t i = 0;
+#if defined(__AVX2__) || defined(__SSSE3__)
+    const uint16_t* epochs = m_epochs.data();
+    // the bump of every type for the rows of epoch 0, which are most of them
+    uint8_t pending[16];
+    for (int type = 0; type < 16; ++type) {
+        pending[type] = static_cast<uint8_t>(m_bumped[type] > MAX_PRIORITY ? MAX_PRIORITY : m_bumped[type]);
+    }
+#endif
+    // Each row looks its bump up by type with a byte shuffle; DEAD has the high bit set, which
+    // yields 0. min(priority + bump, max(priority, 100)) caps live rows and keeps DEAD rows as is.
+    // A block holding a row of a later epoch is done row by row instead.
+#if defined(__AVX2__)
+    __m256i table = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pending)));
+    __m256i cap = _mm256_set1_epi8(MAX_PRIORITY);
+    for (; i + 32 <= count; i += 32) {
+        __m256i stamps = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(epochs + i)),
+                                         _mm256_loadu_si256(reinterpret_cast<const __m256i*>(epochs + i + 16)));
+        if (!_mm256_testz_si256(stamps, stamps)) {
+            for (size_t row = i; row < i + 32; ++row) {
+                if (types[row] != DEAD) {
+                    int bumped = priorities[row] + pendingBump(static_cast<int>(row));
+                    priorities[row] = static_cast<uint8_t>(bumped > MAX_PRIORITY ? MAX_PRIORITY : bumped);
+                }
+            }
+            continue;
+        }
+        __m256i type = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(types + i));
+        __m256i priority = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(priorities + i));
+        __m256i bumped = _mm256_adds_epu8(priority, _mm256_shuffle_epi8(table, type));
+        priority = _mm256_min_epu8(bumped, _mm256_max_epu8(priority, cap));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(priorities + i), priority);
+    }
+#elif defined(__SSSE3__)
+    __m128i table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pending));
+    __m128i cap = _mm_set1_epi8(MAX_PRIORITY);
+    __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= count; i += 16) {
+        __m128i stamps = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(epochs + i)),
+                                      _mm_loadu_si128(reinterpret_cast<const __m128i*>(epochs + i + 8)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(stamps, zero)) != 0xFFFF) {
+            for (size_t row = i; row < i + 16; ++row) {
+                if (types[row] != DEAD) {
+                    int bumped = priorities[row] + pendingBump(static_cast<int>(row));
+                    priorities[row] = static_cast<uint8_t>(bumped > MAX_PRIORITY ? MAX_PRIORITY : bumped);
+                }
+            }
+            continue;
+        }
+        __m128i type = _mm_loadu_si128(reinterpret_cast<const __m128i*>(types + i));
+        __m128i priority = _mm_loadu_si128(reinterpret_cast<const __m128i*>(priorities + i));
+        __m128i bumped = _mm_adds_epu8(priority, _mm_shuffle_epi8(table, type));
+        priority = _mm_min_epu8(bumped, _mm_max_epu8(priority, cap));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(priorities + i), priority);
+    }
+#endif
+    for (; i < count; ++i) {
+        if (types[i] != DEAD) {
+            int bumped = priorities[i] + pendingBump(static_cast<int>(i));
+            priorities[i] = static_cast<uint8_t>(bumped > MAX_PRIORITY ? MAX_PRIORITY : bumped);
+        }
+    }
+    if (m_epochStarts.size() > 1) {
+        std::fill(m_epochs.begin(), m_epochs.end(), 0);
+        m_epochStarts.resize(1);
+    }
+    m_bumped.fill(0);
+    m_hasPending = false;
+}
+
+void TaskStore::compact() {
+    size_t kept = 0;
+    for (size_t row = 0; row < m_ids.size(); ++row) {
+        if (m_types[row] == DEAD) {
+            continue;
+        }
+        m_ids[kept] = m_ids[row];
+        m_owners[kept] = m_owners[row];
+        m_priorities[kept] = m_priorities[row];
+        m_types[kept] = m_types[row];
+        m_descriptions[kept] = m_descriptions[row];
+        m_handles[kept] = m_handles[row];
+        m_epochs[kept] = m_epochs[row];
+        m_rows[indexOf(m_ids[kept])] = static_cast<int>(kept);
+        kept++;
+    }
+    m_ids.resize(kept);
+    m_owners.resize(kept);
+    m_priorities.resize(kept);
+    m_types.resize(kept);
+    m_descriptions.resize(kept);
+    m_handles.resize(kept);
+    m_epochs.resize(kept);
+    m_dead = 0;
+    // ids below the oldest live task and above the newest one will never be looked up again
+    if (kept == 0) {
+        std::vector<int>().swap(m_rows);
+        return;
+    }
+    int first = indexOf(m_ids.front());
+    int last = indexOf(m_ids.back());
+    std::vector<int>(m_rows.begin() + first, m_rows.begin() + last + 1).swap(m_rows);
+    m_baseIndex += first;
+}
+
+// Modifiers
+void TaskStore::add(const Task& task, int owner, const void* handle) {
+    // a new row must not receive the bumps issued before it
+    uint16_t epoch = static_cast<uint16_t>(currentEpoch());
+    int id = task.getId();
+    if (m_rows.empty()) {
+        m_baseIndex = (id - m_firstId) / m_idStride;
+    }
+    int index = (id - m_firstId) / m_idStride - m_baseIndex;
+    if (index >= static_cast<int>(m_rows.size())) {
+        m_rows.resize(index + 1, -1);
+    }
+    m_ids.push_back(id);
+    m_owners.push_back(owner);
+    m_priorities.push_back(static_cast<uint8_t>(task.getPriority()));
+    m_types.push_back(static_cast<uint8_t>(task.getType()));
+    m_descriptions.push_back(task.getDescription());
+    m_handles.push_back(handle);
+    m_epochs.push_back(epoch);
+    m_rows[index] = static_cast<int>(m_ids.size()) - 1;
+}
+
+void TaskStore::remove(int id) {
+    int row = rowOf(id);
+    if (row < 0) {
+        return;
+    }
+    m_types[row] = DEAD;
+    m_priorities[row] = DEAD;
+    m_rows[indexOf(id)] = -1;
+    m_dead++;
+    if (m_dead > 64 && m_dead * 2 > static_cast<int>(m_ids.size())) {
+        compact();
+    }
+}
+
+void TaskStore::setPriority(int id, int priority) {
+    // like a new row, the new priority must not receive the bumps issued before it
+    uint16_t epoch = static_cast<uint16_t>(currentEpoch());
+    int row = rowOf(id);
+    m_priorities[row] = static_cast<uint8_t>(priority);
+    m_epochs[row] = epoch;
+}
+
+void TaskStore::bumpPriority(TaskType type, int priorityBump) {
+    if (priorityBump <= 0) {
+        return;
+    }
+    // only the total matters once it reaches 100, so each bump adds at most that much
+    int32_t& bumped = m_bumped[static_cast<int>(type)];
+    bumped += priorityBump > MAX_PRIORITY ? MAX_PRIORITY : priorityBump;
+    m_hasPending = true;
+    if (bumped > MAX_BUMPED) {
+        applyPending();
+    }
+}
+
+// Lookup
+bool TaskStore::contains(int id) const {
+    return rowOf(id) >= 0;
+}
+
+int TaskStore::owner(int id) const {
+    return m_owners[rowOf(id)];
+}
+
+TaskType TaskStore::type(int id) const {
+    return static_cast<TaskType>(m_types[rowOf(id)]);
+}
+
+int TaskStore::priority(int id) const {
+    int row = rowOf(id);
+    int priority = m_priorities[row] + pendingBump(row);
+    return priority > MAX_PRIORITY ? MAX_PRIORITY : priority;
+}
+
+std::string_view TaskStore::description(int id) const {
+    return m_descriptions[rowOf(id)];
+}
+
+const void* TaskStore::handle(int id) const {
+    return m_handles[rowOf(id)];
+}
+
+void TaskStore::setHandle(int id, const void* handle) {
+    m_handles[rowOf(id)] = handle;
+}
+
+// Scans
+std::vector<int> TaskStore::ids() const {
+    // every live row has a priority in range and dead rows have none
+    return idsInPriorityRange(0, MAX_PRIORITY);
+}
+
+std::vector<int> TaskStore::idsOfType(TaskType type) const {
+    std::vector<int> ids;
+    uint8_t key = static_cast<uint8_t>(type);
+    const uint8_t* types = m_types.data();
+    size_t count = m_types.size();
+    size_t i = 0;
+#if defined(__AVX2__)
+    __m256i wanted = _mm256_set1_epi8(static_cast<char>(key));
+    for (; i + 32 <= count; i += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(types + i));
+        collect(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, wanted))), m_ids.data() + i, ids);
+    }
+#elif defined(__SSE2__)
+    __m128i wanted = _mm_set1_epi8(static_cast<char>(key));
+    for (; i + 16 <= count; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(types + i));
+        collect(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, wanted))), m_ids.data() + i, ids);
+    }
+#endif
+    for (; i < count; ++i) {
+        if (types[i] == key) {
+            ids.push_back(m_ids[i]);
+        }
+    }
+    return ids;
+}
+
+std::vector<int> TaskStore::idsInPriorityRange(int low, int high) const {
+    std::vector<int> ids;
+    if (low < 0) {
+        low = 0;
+    }
+    if (high > MAX_PRIORITY) {
+        high = MAX_PRIORITY;
+    }
+    if (low > high) {
+        return ids;
+    }
+    if (m_hasPending) {
+        applyPending();
+    }
+    // DEAD is above every valid high, so dead rows never match
+    const uint8_t* priorities = m_priorities.data();
+    size_t count = m_priorities.size();
+    size_t i = 0;
+#if defined(__AVX2__)
+    __m256i lowest = _mm256_set1_epi8(static_cast<char>(low));
+    __m256i highest = _mm256_set1_epi8(static_cast<char>(high));
+    for (; i + 32 <= count; i += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(priorities + i));
+        __m256i inRange = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_max_epu8(block, lowest), block),
+                                           _mm256_cmpeq_epi8(_mm256_min_epu8(block, highest), block));
+        collect(static_cast<uint32_t>(_mm256_movemask_epi8(inRange)), m_ids.data() + i, ids);
+    }
+#elif defined(__SSE2__)
+    __m128i lowest = _mm_set1_epi8(static_cast<char>(low));
+    __m128i highest = _mm_set1_epi8(static_cast<char>(high));
+    for (; i + 16 <= count; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(priorities + i));
+        __m128i inRange = _mm_and_si128(_mm_cmpeq_epi8(_mm_max_epu8(block, lowest), block),
+                                        _mm_cmpeq_epi8(_mm_min_epu8(block, highest), block));
+        collect(static_cast<uint32_t>(_mm_movemask_epi8(inRange)), m_ids.data() + i, ids);
+    }
+#endif
+    for (; i < count; ++i) {
+        if (priorities[i] >= low && priorities[i] <= high) {
+            ids.push_back(m_ids[i]);
+        }
+    }
+    return ids;
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "Task.h"
+
+/**
+ * @brief Column store of tasks: one contiguous array per field, one row per task.
+ *
+ * The columns hold the id, the owner (a person slot), the priority, the type and the description
+ * of every task, and the handle of the task in its owner's task list. Queries that test one field
+ * stream through that column only; the type and priority scans compare 16 or 32 rows at a time
+ * with SSE2 or AVX2 when the compiler targets them, and fall back to a plain loop otherwise.
+ *
+ * Rows are appended in id order and a removed row is only marked dead, so scans return ids in
+ * ascending order; dead rows are dropped once they outnumber the live ones. A dead row has the
+ * type and priority DEAD, which no scan matches. The index from id to row covers only the ids
+ * from the oldest live task on, and is trimmed to that range whenever dead rows are dropped.
+ *
+ * Priority bumps are lazy: a bump only adds to a running total for its type, and the priority
+ * column is brought up to date in one vectorized pass before it is next scanned. A row that is
+ * added or given a new priority after a bump is stamped with the current bump epoch instead, so it
+ * does not receive the bumps issued before it and nothing else has to be brought up to date.
+ */
+class TaskStore {
+private:
+    static const uint8_t DEAD = 0xFF;
+
+    std::vector<int32_t> m_ids;
+    std::vector<int32_t> m_owners;
+    // mutable so that pending bumps can be folded in before a const scan
+    mutable std::vector<uint8_t> m_priorities;
+    std::vector<uint8_t> m_types;
+    std::vector<std::string_view> m_descriptions;
+    std::vector<const void*> m_handles;
+
+    // row of every task id, indexed by (id - firstId) / idStride - m_baseIndex, -1 once the task is removed
+    std::vector<int> m_rows;
+    int m_baseIndex;
+    int m_firstId;
+    int m_idStride;
+    int m_dead;
+
+    // bump epoch of every row: the row receives only the bumps issued since its epoch began
+    mutable std::vector<uint16_t> m_epochs;
+    // total bump of every type since the last fold, and what that total was when each epoch began
+    mutable std::array<int32_t, 16> m_bumped;
+    mutable std::vector<std::array<int32_t, 16>> m_epochStarts;
+    mutable bool m_hasPending;
+
+    int currentEpoch();
+    int pendingBump(int row) const;
+    void applyPending() const;
+    void compact();
+    int indexOf(int id) const;
+    int rowOf(int id) const;
+
+public:
+    /**
+     * @brief Constructor to create an empty store.
+     *
+     * @param firstId The lowest task id the store will hold.
+     * @param idStride The distance between consecutive task ids the store will hold.
+     */
+    TaskStore(int firstId = 0, int idStride = 1);
+
+    /**
+     * @brief Adds a task. Its id must be higher than the id of every task added before.
+     *
+     * @param task The task to add.
+     * @param owner The slot of the person the task is assigned to.
+     * @param handle The handle of the task in the person's task list, nullptr if it has none.
+     */
+    void add(const Task& task, int owner, const void* handle = nullptr);
+
+    /**
+     * @brief Removes a task.
+     *
+     * @param id The id of a task in the store.
+     */
+    void remove(int id);
+
+    /**
+     * @brief Checks whether a task is in the store.
+     */
+    bool contains(int id) const;
+
+    /**
+     * @brief Gets the slot of the person a task is assigned to.
+     */
+    int owner(int id) const;
+
+    /**
+     * @brief Gets the type of a task.
+     */
+    TaskType type(int id) const;
+
+    /**
+     * @brief Gets the priority of a task, pending bumps included.
+     */
+    int priority(int id) const;
+
+    /**
+     * @brief Gets the description of a task.
+     */
+    std::string_view description(int id) const;
+
+    /**
+     * @brief Gets the handle of a task in its owner's task list, nullptr if it has none.
+     */
+    const void* handle(int id) const;
+
+    /**
+     * @brief Sets the handle of a task, for when its owner's task list is rebuilt.
+     */
+    void setHandle(int id, const void* handle);
+
+    /**
+     * @brief Sets the priority of a task.
+     *
+     * @param id The id of a task in the store.
+     * @param priority The new priority, already in range [0, 100].
+     */
+    void setPriority(int id, int priority);
+
+    /**
+     * @brief Bumps the priority of all the tasks of a type in O(1), capping it at 100.
+     *
+     * @param type The type of the tasks to bump.
+     * @param priorityBump The non-negative amount added to the priority of each task.
+     */
+    void bumpPriority(TaskType type, int priorityBump);
+
+    /**
+     * @brief Gets the ids of all the tasks, in ascending order.
+     */
+    std::vector<int> ids() const;
+
+    /**
+     * @brief Gets the ids of all the tasks of a type, in ascending order.
+     */
+    std::vector<int> idsOfType(TaskType type) const;
+
+    /**
+     * @brief Gets the ids of all the tasks with a priority in [low, high], in ascending order.
+     */
+    std::vector<int> idsInPriorityRange(int low, int high) const;
+};
@@ -0,0 +1,111 @@
+#include "TaskWriter.h"
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+// Sinks
+OstreamSink::OstreamSink(std::ostream& os) : m_os(os) {}
+
+void OstreamSink::write(const char* data, size_t size) {
+    m_os.write(data, static_cast<std::streamsize>(size));
+}
+
+void OstreamSink::flush() {
+    m_os.flush();
+}
+
+FileDescriptorSink::FileDescriptorSink(int fd) : m_fd(fd) {}
+
+void FileDescriptorSink::write(const char* data, size_t size) {
+#if defined(__unix__) || defined(__APPLE__)
+    while (size > 0) {
+        ssize_t written = ::write(m_fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Error: Writing to a file descriptor failed.");
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+#else
+    (void)data;
+    (void)size;
+    throw std::runtime_error("Error: File descriptors are not supported on this platform.");
+#endif
+}
+
+StringSink::StringSink(std::string& out) : m_out(out) {}
+
+void StringSink::write(const char* data, size_t size) {
+    m_out.append(data, size);
+}
+
+// Writer
+TaskWriter::TaskWriter(OutputSink& sink) : m_sink(sink), m_used(0) {}
+
+void TaskWriter::flush() {
+    if (m_used > 0) {
+        m_sink.write(m_buffer, m_used);
+        m_used = 0;
+    }
+    m_sink.flush();
+}
+
+void TaskWriter::write(std::string_view text) {
+    if (text.empty()) {
+        return;
+    }
+    if (text.size() > BUFFER_SIZE - m_used) {
+        if (m_used > 0) {
+            m_sink.write(m_buffer, m_used);
+            m_used = 0;
+        }
+        if (text.size() >= BUFFER_SIZE) {
+            m_sink.write(text.data(), text.size());
+            return;
+        }
+    }
+    std::memcpy(m_buffer + m_used, text.data(), text.size());
+    m_used += text.size();
+}
+
+void TaskWriter::write(char c) {
+    if (m_used == BUFFER_SIZE) {
+        m_sink.write(m_buffer, m_used);
+        m_used = 0;
+    }
+    m_buffer[m_used++] = c;
+}
+
+void TaskWriter::write(int value) {
+    char digits[16];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    write(std::string_view(digits, static_cast<size_t>(result.ptr - digits)));
+}
+
+void TaskWriter::writeTask(const Task& task) {
+    write("Task ID: ");
+    write(task.getId());
+    write(", Priority: ");
+    write(task.getPriority());
+    write(", Type: ");
+    write(taskTypeName(task.getType()));
+    write(", Description: ");
+    write(task.getDescription());
+}
+
+void TaskWriter::writePerson(const Person& person) {
+    write("Person: ");
+    write(person.getName());
+    write('\n');
+    for (const Task& task : person.getTasks()) {
+        writeTask(task);
+        write('\n');
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include "Task.h"
+#include "Person.h"
+
+/**
+ * @brief Destination for the bytes produced by a TaskWriter.
+ */
+class OutputSink {
+public:
+    virtual ~OutputSink() = default;
+
+    /**
+     * @brief Writes a block of bytes.
+     */
+    virtual void write(const char* data, size_t size) = 0;
+
+    /**
+     * @brief Pushes the written bytes to their final destination, if the sink buffers them.
+     */
+    virtual void flush() {}
+};
+
+/**
+ * @brief Sink writing to an output stream.
+ */
+class OstreamSink : public OutputSink {
+    std::ostream& m_os;
+
+public:
+    explicit OstreamSink(std::ostream& os);
+    void write(const char* data, size_t size) override;
+    void flush() override;
+};
+
+/**
+ * @brief Sink writing straight to a file descriptor, such as 1 for the standard output.
+ */
+class FileDescriptorSink : public OutputSink {
+    int m_fd;
+
+public:
+    explicit FileDescriptorSink(int fd);
+    void write(const char* data, size_t size) override;
+};
+
+/**
+ * @brief Sink appending to a string in memory.
+ */
+class StringSink : public OutputSink {
+    std::string& m_out;
+
+public:
+    explicit StringSink(std::string& out);
+    void write(const char* data, size_t size) override;
+};
+
+/**
+ * @brief Formats tasks and persons into a fixed buffer and hands it to a sink when it fills up.
+ *
+ * Produces exactly the text of the operator<< overloads of Task and Person, but never allocates:
+ * numbers are formatted in place and type names come from a static table. Nothing reaches the
+ * sink's final destination before flush(), which should be called once at the end.
+ */
+class TaskWriter {
+private:
+    static const size_t BUFFER_SIZE = 64 * 1024;
+
+    OutputSink& m_sink;
+    char m_buffer[BUFFER_SIZE];
+    size_t m_used;
+
+public:
+    /**
+     * @brief Constructor to create a TaskWriter.
+     *
+     * @param sink The sink receiving the formatted text.
+     */
+    explicit TaskWriter(OutputSink& sink);
+    TaskWriter(const TaskWriter& other) = delete;
+    TaskWriter& operator=(const TaskWriter& other) = delete;
+
+    /**
+     * @brief Writes the buffered text to the sink and flushes the sink.
+     */
+    void flush();
+
+    void write(std::string_view text);
+    void write(char c);
+    void write(int value);
+
+    /**
+     * @brief Writes a task the way operator<< does, without a line break.
+     */
+    void writeTask(const Task& task);
+
+    /**
+     * @brief Writes a person the way operator<< does: a header line and one line per task.
+     */
+    void writePerson(const Person& person);
+};
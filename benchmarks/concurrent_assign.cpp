@@ -0,0 +1,59 @@
+// Throughput of assignTask/completeTask on ConcurrentTaskManager as threads are added.
+// Every thread works on its own people, so the shards are the only thing the threads share.
+//
+// Build from the repository root:
+//   g++ -std=c++17 -O2 -pthread -I. benchmarks/concurrent_assign.cpp $(ls *.cpp | grep -v main.cpp) -o concurrent_assign
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ConcurrentTaskManager.h"
+
+static const int OPERATIONS_PER_THREAD = 200000;
+static const int PEOPLE_PER_THREAD = 64;
+
+static double run(int threadCount) {
+    ConcurrentTaskManager manager(64);
+    std::vector<std::vector<PersonHandle>> people(threadCount);
+    for (int t = 0; t < threadCount; t++) {
+        for (int p = 0; p < PEOPLE_PER_THREAD; p++) {
+            people[t].push_back(manager.getPersonHandle("person" + std::to_string(t) + "_" + std::to_string(p)));
+        }
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; t++) {
+        threads.emplace_back([&manager, &mine = people[t]]() {
+            for (int i = 0; i < OPERATIONS_PER_THREAD; i++) {
+                PersonHandle person = mine[(i / 4) % PEOPLE_PER_THREAD];
+                // three assignments for every completion keeps the queues growing slowly
+                if (i % 4 == 3) {
+                    manager.completeTask(person);
+                } else {
+                    manager.assignTask(person, Task(i % 101, TaskType::Development));
+                }
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return threadCount * OPERATIONS_PER_THREAD / elapsed.count();
+}
+
+int main() {
+    int maxThreads = static_cast<int>(std::thread::hardware_concurrency());
+    maxThreads = maxThreads > 0 ? maxThreads : 4;
+    double single = 0;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        double perSecond = run(threads);
+        single = threads == 1 ? perSecond : single;
+        std::cout << threads << " threads: " << static_cast<long long>(perSecond) << " ops/s, speedup "
+                  << perSecond / single << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,34 @@
+// Throughput and per-priority latency of TaskExecutor when all work lands on one worker.
+// The other workers only get work by stealing, so the run shows how well stealing spreads load.
+//
+// Build from the repository root:
+//   g++ -std=c++17 -O2 -pthread -I. benchmarks/executor_stealing.cpp $(ls *.cpp | grep -v main.cpp) -o executor_stealing
+
+#include <atomic>
+#include <iostream>
+#include "TaskExecutor.h"
+
+static const int TASKS = 200000;
+
+int main() {
+    std::atomic<long long> sink(0);
+    TaskExecutor executor;
+    for (int i = 0; i < TASKS; i++) {
+        executor.submit(0, Task(i % 101, TaskType::Development), [&sink, i]() {
+            unsigned long long value = static_cast<unsigned long long>(i);
+            for (int step = 0; step < 200; step++) {
+                value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+            }
+            sink += value & 1;
+        });
+    }
+    executor.wait();
+
+    ExecutorStats stats = executor.stats();
+    std::cout << executor.workerCount() << " workers: " << static_cast<long long>(stats.throughput()) << " tasks/s, "
+              << stats.stolen << " of " << stats.executed << " stolen" << std::endl;
+    for (int priority = 100; priority >= 0; priority -= 25) {
+        std::cout << "priority " << priority << ": mean latency " << stats.meanLatency(priority) << " us" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,57 @@
+// Producer-side latency of TaskIntake::assignTask as producer threads are added.
+// A call only queues a command, so its latency should stay flat while the applier keeps up.
+//
+// Build from the repository root:
+//   g++ -std=c++17 -O2 -pthread -I. benchmarks/intake_latency.cpp $(ls *.cpp | grep -v main.cpp) -o intake_latency
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "TaskIntake.h"
+
+static const int CALLS_PER_THREAD = 100000;
+
+static void run(int threadCount) {
+    TaskManager manager;
+    std::vector<std::vector<long long>> latencies(threadCount);
+    {
+        TaskIntake intake(manager, 1 << 16);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; t++) {
+            threads.emplace_back([&intake, &mine = latencies[t], t]() {
+                std::string name = "producer" + std::to_string(t);
+                mine.reserve(CALLS_PER_THREAD);
+                for (int i = 0; i < CALLS_PER_THREAD; i++) {
+                    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                    intake.assignTask(name, Task(i % 101, TaskType::Development), [](int, std::exception_ptr) {});
+                    std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+                    mine.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+                }
+            });
+        }
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+    }
+
+    std::vector<long long> all;
+    for (const std::vector<long long> &mine : latencies) {
+        all.insert(all.end(), mine.begin(), mine.end());
+    }
+    std::sort(all.begin(), all.end());
+    std::cout << threadCount << " producers: p50 " << all[all.size() / 2] << " ns, p99 " << all[all.size() * 99 / 100]
+              << " ns, p99.9 " << all[all.size() * 999 / 1000] << " ns" << std::endl;
+}
+
+int main() {
+    int maxThreads = static_cast<int>(std::thread::hardware_concurrency());
+    maxThreads = maxThreads > 0 ? maxThreads : 4;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        run(threads);
+    }
+    return 0;
+}
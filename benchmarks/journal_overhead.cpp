@@ -0,0 +1,55 @@
+// Cost of journaling assignTask, by group size, compared with no journal, and the time to recover.
+// The time of the assignments themselves is reported apart from the final wait for the disk.
+//
+// Build from the repository root:
+//   g++ -std=c++17 -O2 -pthread -I. benchmarks/journal_overhead.cpp $(ls *.cpp | grep -v main.cpp) -o journal_overhead
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include "TaskManager.h"
+
+static const int PERSONS = 1000;
+static const int TASKS = 200000;
+
+static void assignAll(TaskManager &manager, const char *label) {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    unsigned int seed = 1;
+    for (int i = 0; i < TASKS; i++) {
+        seed = seed * 1103515245u + 12345u;
+        manager.assignTask("person" + std::to_string(seed % PERSONS),
+                           Task(static_cast<int>(seed >> 8) % 101, static_cast<TaskType>((seed >> 4) % TASK_TYPE_COUNT),
+                                "description " + std::to_string(seed % 1000)));
+    }
+    Clock::time_point assigned = Clock::now();
+    manager.syncJournal();
+    std::cout << label << " " << std::chrono::duration<double, std::milli>(assigned - start).count() << " ms, then "
+              << std::chrono::duration<double, std::milli>(Clock::now() - assigned).count() << " ms to sync" << std::endl;
+}
+
+int main() {
+    typedef std::chrono::steady_clock Clock;
+    const char *journal = "journal_overhead.log";
+
+    TaskManager plain;
+    assignAll(plain, "no journal");
+
+    const int groupSizes[] = {1, 16, 256, 4096};
+    for (int groupSize : groupSizes) {
+        std::remove(journal);
+        TaskManager logged;
+        logged.openJournal(journal, groupSize, 10);
+        assignAll(logged, ("group of " + std::to_string(groupSize)).c_str());
+    }
+
+    Clock::time_point start = Clock::now();
+    TaskManager recovered;
+    recovered.recover("journal_overhead.snap", journal);
+    std::cout << "recover " << std::chrono::duration<double, std::milli>(Clock::now() - start).count() << " ms, "
+              << recovered.countAbove(-1) << " tasks" << std::endl;
+    recovered.closeJournal();
+    std::remove(journal);
+    return 0;
+}
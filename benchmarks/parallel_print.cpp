@@ -0,0 +1,53 @@
+// Time of printAllTasks and printAllEmployees into memory as TaskManager::setParallelism grows.
+// Every run must produce the same bytes as the serial one; the program checks that as it goes.
+//
+// Build from the repository root:
+//   g++ -std=c++17 -O2 -pthread -I. benchmarks/parallel_print.cpp $(ls *.cpp | grep -v main.cpp) -o parallel_print
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "TaskManager.h"
+
+static const int PERSONS = 2000;
+static const int TASKS = 1000000;
+
+int main() {
+    TaskManager manager;
+    unsigned int seed = 1;
+    for (int i = 0; i < TASKS; i++) {
+        seed = seed * 1103515245u + 12345u;
+        manager.assignTask("person" + std::to_string(seed % PERSONS),
+                           Task(static_cast<int>(seed >> 8) % 101, static_cast<TaskType>((seed >> 4) % TASK_TYPE_COUNT)));
+    }
+
+    std::string serialTasks;
+    std::string serialEmployees;
+    int maxThreads = static_cast<int>(std::thread::hardware_concurrency());
+    maxThreads = maxThreads > 0 ? maxThreads : 4;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        manager.setParallelism(threads);
+        std::string tasks;
+        std::string employees;
+        StringSink tasksSink(tasks);
+        StringSink employeesSink(employees);
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        manager.printAllTasks(tasksSink);
+        std::chrono::steady_clock::time_point middle = std::chrono::steady_clock::now();
+        manager.printAllEmployees(employeesSink);
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+        if (threads == 1) {
+            serialTasks = tasks;
+            serialEmployees = employees;
+        }
+        bool identical = tasks == serialTasks && employees == serialEmployees;
+        std::cout << threads << " threads: printAllTasks "
+                  << std::chrono::duration<double, std::milli>(middle - start).count() << " ms, printAllEmployees "
+                  << std::chrono::duration<double, std::milli>(end - middle).count() << " ms"
+                  << (identical ? "" : ", OUTPUT DIFFERS") << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,44 @@
+// Startup from a snapshot compared with replaying every assignTask.
+//
+// Build from the repository root:
+//   g++ -std=c++17 -O2 -pthread -I. benchmarks/snapshot_load.cpp $(ls *.cpp | grep -v main.cpp) -o snapshot_load
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include "TaskManager.h"
+
+static const int PERSONS = 10000;
+static const int TASKS = 1000000;
+
+static void replay(TaskManager &manager) {
+    unsigned int seed = 1;
+    for (int i = 0; i < TASKS; i++) {
+        seed = seed * 1103515245u + 12345u;
+        manager.assignTask("person" + std::to_string(seed % PERSONS),
+                           Task(static_cast<int>(seed >> 8) % 101, static_cast<TaskType>((seed >> 4) % TASK_TYPE_COUNT),
+                                "description " + std::to_string(seed % 1000)));
+    }
+}
+
+int main() {
+    typedef std::chrono::steady_clock Clock;
+    const char *path = "snapshot_load.bin";
+
+    Clock::time_point start = Clock::now();
+    TaskManager replayed;
+    replay(replayed);
+    Clock::time_point replayedAt = Clock::now();
+    replayed.saveSnapshot(path);
+    Clock::time_point savedAt = Clock::now();
+    TaskManager loaded;
+    loaded.loadSnapshot(path);
+    Clock::time_point loadedAt = Clock::now();
+    std::remove(path);
+
+    std::cout << "replay " << std::chrono::duration<double, std::milli>(replayedAt - start).count() << " ms, save "
+              << std::chrono::duration<double, std::milli>(savedAt - replayedAt).count() << " ms, load "
+              << std::chrono::duration<double, std::milli>(loadedAt - savedAt).count() << " ms" << std::endl;
+    return 0;
+}
@@ -1,6 +1,19 @@
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <future>
 #include <iostream>
+#include <iterator>
+#include <sstream>
+#include <thread>
 #include "TaskManager.h"
+#include "ConcurrentTaskManager.h"
+#include "TaskIntake.h"
+#include "TaskExecutor.h"
+#include "TaskSnapshot.h"
 #include "Task.h"
 
 using std::cout;
@@ -436,13 +449,14 @@ bool testTaskManagerAssignTask()
     manager.assignTask("Hank", task9);
     manager.assignTask("Bonie", task10);
 
+    // the number of persons is no longer capped, an 11th person is accepted
     try
     {
         manager.assignTask("boom", task11);
-        return false; // should have thrown exception
     }
     catch (std::exception &e)
     {
+        return false;
     }
 
     manager.assignTask("Bob", task12);
@@ -457,6 +471,1342 @@ bool testTaskManagerAssignTask()
 }
 
 
+bool testSkipList()
+{
+    SortedList<int, mtm::SkipListBackend> list;
+    for (int i = 0; i < 1000; ++i)
+    {
+        list.insert((i * 7919) % 1000);
+    }
+    ASSERT_TEST(list.length() == 1000);
+
+    int expected = 999;
+    for (int value : list)
+    {
+        ASSERT_TEST(value == expected);
+        expected--;
+    }
+
+    // remove every even value, including the head
+    for (auto it = list.begin(); it != list.end();)
+    {
+        auto current = it;
+        ++it;
+        if (*current % 2 == 0)
+        {
+            list.remove(current);
+        }
+    }
+    ASSERT_TEST(list.length() == 500);
+    ASSERT_TEST(*list.begin() == 999);
+
+    SortedList<int, mtm::SkipListBackend> copy(list);
+    list.insert(5000);
+    ASSERT_TEST(copy.length() == 500);
+    ASSERT_TEST(*list.begin() == 5000);
+
+    expected = 999;
+    for (int value : copy)
+    {
+        ASSERT_TEST(value == expected);
+        expected -= 2;
+    }
+
+    SortedList<int, mtm::SkipListBackend> other;
+    other.insert(1);
+    try
+    {
+        list.remove(other.begin());
+        return false;
+    }
+    catch (const std::invalid_argument &)
+    {
+    }
+
+    return true;
+}
+
+bool testListMoveAndEmplace()
+{
+    SortedList<Task> list;
+    list.emplace(3, TaskType::Testing, "third");
+    list.insert(Task(7, TaskType::Research, "first"));
+    Task task(5, TaskType::General, "second");
+    list.insert(std::move(task));
+    ASSERT_TEST(list.length() == 3);
+    ASSERT_TEST((*list.begin()).getPriority() == 7);
+
+    // moving leaves the source empty and keeps the elements
+    SortedList<Task> moved(std::move(list));
+    ASSERT_TEST(list.length() == 0);
+    ASSERT_TEST(moved.length() == 3);
+
+    // assigning over a longer and a shorter list reuses the existing nodes
+    SortedList<Task> target;
+    for (int i = 0; i < 10; ++i)
+    {
+        target.emplace(i, TaskType::General);
+    }
+    target = moved;
+    ASSERT_TEST(target.length() == 3);
+    int expected[] = {7, 5, 3};
+    int i = 0;
+    for (const Task &t : target)
+    {
+        ASSERT_TEST(t.getPriority() == expected[i++]);
+    }
+    SortedList<Task> empty;
+    target = empty;
+    ASSERT_TEST(target.length() == 0);
+
+    list = std::move(moved);
+    ASSERT_TEST(list.length() == 3);
+    ASSERT_TEST(moved.length() == 0);
+
+    // blocks allocated on one thread and freed on another flow back instead of piling up
+    struct CrossThreadTag;
+    typedef mtm::NodePool<32, alignof(void *), CrossThreadTag> CrossThreadPool;
+    TaskExecutor consumer(1);
+    size_t slabsAfterFirstRound = 0;
+    for (int round = 0; round < 20; round++)
+    {
+        std::shared_ptr<std::vector<void *>> blocks = std::make_shared<std::vector<void *>>();
+        for (int i = 0; i < 20000; i++)
+        {
+            blocks->push_back(CrossThreadPool::instance().allocate());
+        }
+        consumer.submit(Task(0, TaskType::General), [blocks]() {
+            for (void *block : *blocks)
+            {
+                CrossThreadPool::instance().deallocate(block);
+            }
+        });
+        consumer.wait();
+        if (round == 0)
+        {
+            slabsAfterFirstRound = CrossThreadPool::slabCount();
+        }
+    }
+    ASSERT_TEST(slabsAfterFirstRound > 0 && CrossThreadPool::slabCount() <= slabsAfterFirstRound + 3);
+    return true;
+}
+
+bool testListFrontAndRemove()
+{
+    SortedList<int, mtm::SkipListBackend> list;
+    for (int i = 0; i < 100; ++i)
+    {
+        list.insert(i);
+    }
+    ASSERT_TEST(list.front() == 99);
+    list.pop_front();
+    ASSERT_TEST(list.front() == 98);
+    ASSERT_TEST(list.length() == 99);
+
+    // remove through an iterator in the middle of the list, then keep iterating from it
+    auto it = list.begin();
+    for (int i = 0; i < 10; ++i)
+    {
+        ++it;
+    }
+    ASSERT_TEST(*it == 88);
+    auto next = it;
+    ++next;
+    list.remove(it);
+    ASSERT_TEST(*next == 87);
+    ASSERT_TEST(list.length() == 98);
+
+    while (list.length() > 0)
+    {
+        list.pop_front();
+    }
+    try
+    {
+        list.pop_front();
+        return false;
+    }
+    catch (const std::out_of_range &)
+    {
+    }
+    try
+    {
+        list.front();
+        return false;
+    }
+    catch (const std::out_of_range &)
+    {
+    }
+    list.insert(1);
+    ASSERT_TEST(list.front() == 1 && list.length() == 1);
+
+    // a node of another list with the same shape is not mistaken for one of this list
+    SortedList<int> shaped;
+    SortedList<int> twin;
+    for (int i = 0; i < 3; ++i)
+    {
+        shaped.insert(i);
+        twin.insert(i);
+    }
+    auto foreign = twin.begin();
+    ++foreign;
+    try
+    {
+        shaped.remove(foreign);
+        return false;
+    }
+    catch (const std::invalid_argument &)
+    {
+    }
+    ASSERT_TEST(shaped.length() == 3 && twin.length() == 3);
+    return true;
+}
+
+bool testListMergeAndSplit()
+{
+    int values[] = {4, 9, 1, 7, 3};
+    SortedList<int> list(values, values + 5);
+    ASSERT_TEST(list.length() == 5);
+    ASSERT_TEST(list.front() == 9);
+
+    SortedList<int> other;
+    other.insert(8);
+    other.insert(2);
+    other.insert(10);
+
+    // copying merge leaves the source intact, moving merge empties it
+    SortedList<int> copy(list);
+    copy.merge(other);
+    ASSERT_TEST(copy.length() == 8);
+    ASSERT_TEST(other.length() == 3);
+    list.merge(std::move(other));
+    ASSERT_TEST(other.length() == 0);
+
+    int expected[] = {10, 9, 8, 7, 4, 3, 2, 1};
+    int i = 0;
+    for (int value : list)
+    {
+        ASSERT_TEST(value == expected[i++]);
+    }
+
+    auto middle = list.begin();
+    ++middle;
+    ++middle;
+    ++middle;
+    SortedList<int> low = list.split(middle);
+    ASSERT_TEST(list.length() == 3 && low.length() == 5);
+    ASSERT_TEST(low.front() == 7);
+
+    // move 4 and 3 back into the upper list
+    auto first = low.begin();
+    ++first;
+    auto last = first;
+    ++last;
+    ++last;
+    list.splice(low, first, last);
+    ASSERT_TEST(list.length() == 5 && low.length() == 3);
+    i = 0;
+    int upper[] = {10, 9, 8, 4, 3};
+    for (int value : list)
+    {
+        ASSERT_TEST(value == upper[i++]);
+    }
+    i = 0;
+    int lower[] = {7, 2, 1};
+    for (int value : low)
+    {
+        ASSERT_TEST(value == lower[i++]);
+    }
+
+    // last must belong to the same list as first and not come before it
+    auto second = low.begin();
+    ++second;
+    try
+    {
+        list.splice(low, low.begin(), list.begin());
+        return false;
+    }
+    catch (const std::invalid_argument &)
+    {
+    }
+    try
+    {
+        list.splice(low, second, low.begin());
+        return false;
+    }
+    catch (const std::invalid_argument &)
+    {
+    }
+    ASSERT_TEST(list.length() == 5 && low.length() == 3);
+
+    // an iterator into another list is rejected, even one past that list's first node
+    try
+    {
+        list.split(second);
+        return false;
+    }
+    catch (const std::invalid_argument &)
+    {
+    }
+    try
+    {
+        low.splice(list, second, low.end());
+        return false;
+    }
+    catch (const std::invalid_argument &)
+    {
+    }
+    ASSERT_TEST(list.length() == 5 && low.length() == 3);
+
+    // nodes that moved keep working with the list they moved to
+    SortedList<int> moved(std::move(low));
+    moved.remove(second);
+    ASSERT_TEST(moved.length() == 2 && moved.front() == 7 && moved.back() == 1);
+    return true;
+}
+
+bool testListViews()
+{
+    SortedList<int> list;
+    for (int i = 1; i <= 10; ++i)
+    {
+        list.insert(i);
+    }
+
+    int calls = 0;
+    auto isEven = [&calls](int value) {
+        calls++;
+        return value % 2 == 0;
+    };
+    auto negate = [](int value) { return -value; };
+
+    // nothing is evaluated until the view is iterated
+    auto view = list.view().filter(isEven).apply(negate).take(3);
+    ASSERT_TEST(calls == 0);
+    int expected[] = {-10, -8, -6};
+    int i = 0;
+    for (int value : view)
+    {
+        ASSERT_TEST(value == expected[i++]);
+    }
+    ASSERT_TEST(i == 3);
+
+    SortedList<int> evens = list.view().filter(isEven).materialize();
+    ASSERT_TEST(evens.length() == 5 && evens.front() == 10);
+
+    SortedList<int> negated = view.materialize();
+    ASSERT_TEST(negated.length() == 3 && negated.front() == -6);
+
+    SortedList<int> filtered = list.filter(isEven);
+    SortedList<int> applied = list.apply(negate);
+    ASSERT_TEST(filtered.length() == 5 && applied.length() == 10);
+    ASSERT_TEST(applied.front() == -1);
+    return true;
+}
+
+bool testFlatSortedList()
+{
+    mtm::FlatSortedList<int> list;
+    for (int i = 0; i < 200; ++i)
+    {
+        list.insert((i * 37) % 100);
+    }
+    ASSERT_TEST(list.length() == 200);
+    int previous = 100;
+    for (int value : list)
+    {
+        ASSERT_TEST(value <= previous);
+        previous = value;
+    }
+    ASSERT_TEST(list.front() == 99);
+    list.pop_front();
+    ASSERT_TEST(list.front() == 99);
+    list.pop_front();
+    ASSERT_TEST(list.front() == 98);
+
+    auto it = list.begin();
+    ++it;
+    ++it;
+    list.remove(it);
+    ASSERT_TEST(list.length() == 197);
+
+    mtm::FlatSortedList<Task> tasks;
+    tasks.insert(Task(3, TaskType::Testing, "first"));
+    tasks.insert(Task(3, TaskType::Testing, "second"));
+    tasks.insert(Task(8, TaskType::Research, "top"));
+    ASSERT_TEST(tasks.front().getPriority() == 8);
+    mtm::FlatSortedList<Task> testing = tasks.filter([](const Task &t) { return t.getType() == TaskType::Testing; });
+    ASSERT_TEST(testing.length() == 2);
+    ASSERT_TEST(testing.front().getDescription() == "second");
+    return true;
+}
+
+bool testTaskBucketQueue()
+{
+    TaskBucketQueue queue;
+    ASSERT_TEST(queue.topPriority() == -1);
+    Task first(5, TaskType::General, "first");
+    first.setId(1);
+    Task second(5, TaskType::General, "second");
+    second.setId(2);
+    queue.insert(first);
+    queue.insert(Task(100, TaskType::Research, "top"));
+    queue.insert(second);
+    queue.insert(Task(0, TaskType::Testing, "bottom"));
+    ASSERT_TEST(queue.length() == 4);
+    ASSERT_TEST(queue.topPriority() == 100);
+
+    const char *expected[] = {"top", "first", "second", "bottom"};
+    int i = 0;
+    for (const Task &task : queue)
+    {
+        ASSERT_TEST(task.getDescription() == expected[i++]);
+    }
+
+    queue.pop_front();
+    ASSERT_TEST(queue.front().getDescription() == "first");
+    ASSERT_TEST(queue.topPriority() == 5);
+
+    auto it = queue.begin();
+    ++it;
+    queue.remove(it);
+    ASSERT_TEST(queue.length() == 2);
+    ASSERT_TEST((*++queue.begin()).getDescription() == "bottom");
+
+    TaskBucketQueue copy(queue);
+    queue.pop_front();
+    queue.pop_front();
+    ASSERT_TEST(queue.length() == 0 && copy.length() == 2);
+
+    // a transform that throws half way keeps every task, in order
+    int transformed = 0;
+    try
+    {
+        copy.transform([&transformed](Task &task) {
+            if (transformed++ == 1)
+            {
+                throw std::runtime_error("stop");
+            }
+            task.setPriority(task.getPriority() + 1);
+        });
+        return false;
+    }
+    catch (const std::runtime_error &)
+    {
+    }
+    ASSERT_TEST(copy.length() == 2 && copy.front().getPriority() == 6 && copy.back().getPriority() == 0);
+
+    // equal priorities are completed in assignment order
+    TaskManager manager;
+    manager.assignTask("Alice", Task(3, TaskType::General, "older"));
+    manager.assignTask("Alice", Task(3, TaskType::Testing, "newer"));
+    manager.assignTask("Alice", Task(1, TaskType::General, "low"));
+    manager.printAllEmployees();
+    manager.completeTask("Alice");
+    manager.printAllEmployees();
+    return true;
+}
+
+bool testTaskManagerManyPersons()
+{
+    TaskManager manager;
+    const int persons = 20000;
+    for (int i = 0; i < persons; ++i)
+    {
+        manager.assignTask("person" + std::to_string(i), Task(i % 101, TaskType::General, "first"));
+    }
+    for (int i = 0; i < persons; i += 2)
+    {
+        manager.assignTask("person" + std::to_string(i), Task(0, TaskType::General, "second"));
+    }
+    for (int i = 0; i < persons; ++i)
+    {
+        manager.completeTask("person" + std::to_string(i));
+    }
+    // only the even persons still have a task left
+    for (int i = 0; i < persons; ++i)
+    {
+        try
+        {
+            manager.completeTask("person" + std::to_string(i));
+            ASSERT_TEST(i % 2 == 0);
+        }
+        catch (const std::runtime_error &)
+        {
+            ASSERT_TEST(i % 2 == 1);
+        }
+    }
+    // unknown persons are ignored
+    manager.completeTask("nobody");
+    return true;
+}
+
+bool testTaskManagerHandles()
+{
+    TaskManager manager;
+    PersonHandle alice = manager.getPersonHandle("Alice");
+    PersonHandle bob = manager.getPersonHandle("Bob");
+    ASSERT_TEST(alice.id != bob.id);
+    ASSERT_TEST(manager.getPersonHandle("Alice").id == alice.id);
+
+    manager.assignTask(alice, Task(4, TaskType::Research, "by handle"));
+    manager.assignTask("Alice", Task(9, TaskType::Testing, "by name"));
+    manager.assignTask(bob, Task(1, TaskType::General, "bob's"));
+    manager.completeTask(alice);
+    manager.printAllEmployees();
+
+    try
+    {
+        manager.completeTask(PersonHandle(42));
+        return false;
+    }
+    catch (const std::invalid_argument &)
+    {
+    }
+    return true;
+}
+
+bool testPersonBumpByType()
+{
+    Person person("Dana");
+    Task a(99, TaskType::Testing, "a");
+    a.setId(5);
+    Task b(98, TaskType::Testing, "b");
+    b.setId(2);
+    Task c(50, TaskType::Research, "c");
+    c.setId(1);
+    Task d(97, TaskType::Research, "d");
+    d.setId(3);
+    person.assignTask(a);
+    person.assignTask(b);
+    person.assignTask(c);
+    person.assignTask(d);
+    ASSERT_TEST(person.getTasks().length() == 4);
+    ASSERT_TEST(person.getHighestPriorityTask().getId() == 5);
+
+    // both testing tasks reach the cap of 100, so the older one must come first
+    person.bumpPriorityByType(TaskType::Testing, 5);
+    ASSERT_TEST(person.getTasks(TaskType::Testing).front().getId() == 2);
+    ASSERT_TEST(person.getTasks(TaskType::Research).front().getId() == 3);
+    int expected[] = {2, 5, 3, 1};
+    int i = 0;
+    for (const Task& task : person.getTasks())
+    {
+        ASSERT_TEST(task.getId() == expected[i++]);
+    }
+    ASSERT_TEST(i == 4);
+
+    // iterators compare by position, not only by how many tasks are left
+    auto first = person.getTasks().begin();
+    auto second = person.getTasks().begin();
+    ASSERT_TEST(first == second && first != person.getTasks().end());
+    ++second;
+    ASSERT_TEST(first != second);
+    Person copy(person);
+    ASSERT_TEST(copy.getTasks().begin() != first && copy.getTasks().length() == 4);
+    ASSERT_TEST(Person("Idle").getTasks(TaskType::Testing).length() == 0);
+
+    ASSERT_TEST(person.completeTask() == 2);
+    ASSERT_TEST(person.completeTask() == 5);
+    person.bumpPriorityByType(TaskType::Research, 60);
+    ASSERT_TEST(person.completeTask() == 1);
+    ASSERT_TEST(person.completeTask() == 3);
+    try
+    {
+        person.completeTask();
+        return false;
+    }
+    catch (const std::runtime_error &)
+    {
+    }
+    return true;
+}
+
+bool testTaskManagerLazyBump()
+{
+    TaskManager manager;
+    manager.assignTask("Eve", Task(40, TaskType::Testing, "old test"));
+    manager.assignTask("Eve", Task(95, TaskType::Testing, "older test"));
+    manager.assignTask("Eve", Task(60, TaskType::Research, "research"));
+    for (int i = 0; i < 1000; i++)
+    {
+        manager.bumpPriorityByType(TaskType::Testing, 1);
+    }
+    // assigned after the bumps, so it keeps its own priority
+    manager.assignTask("Eve", Task(10, TaskType::Testing, "new test"));
+    manager.assignTask("Frank", Task(70, TaskType::Testing, "frank's test"));
+    manager.bumpPriorityByType(TaskType::Testing, 5);
+    manager.printAllEmployees();
+    manager.completeTask("Eve");
+    manager.compact();
+    manager.printTasksByType(TaskType::Testing);
+    return true;
+}
+
+bool testMergeIterator()
+{
+    SortedList<int> first;
+    SortedList<int> second;
+    SortedList<int> empty;
+    for (int i = 0; i < 10; i += 2)
+    {
+        first.insert(i);
+        second.insert(i + 1);
+    }
+    second.insert(4);
+    mtm::MergeRange<SortedList<int>::ConstIterator> merged;
+    merged.add(first.begin(), first.end());
+    merged.add(empty.begin(), empty.end());
+    merged.add(second.begin(), second.end());
+    int expected[] = {9, 8, 7, 6, 5, 4, 4, 3, 2, 1, 0};
+    int i = 0;
+    for (int value : merged)
+    {
+        ASSERT_TEST(i < 11 && value == expected[i]);
+        i++;
+    }
+    ASSERT_TEST(i == 11);
+
+    mtm::MergeRange<SortedList<int>::ConstIterator> none;
+    ASSERT_TEST(!(none.begin() != none.end()));
+    try
+    {
+        *none.begin();
+        return false;
+    }
+    catch (const std::range_error &)
+    {
+    }
+    return true;
+}
+
+bool testTaskManagerRankQueries()
+{
+    TaskManager manager;
+    manager.assignTask("Gil", Task(50, TaskType::Testing, "a"));
+    manager.assignTask("Gil", Task(90, TaskType::Research, "b"));
+    manager.assignTask("Hana", Task(70, TaskType::Testing, "c"));
+    manager.assignTask("Hana", Task(10, TaskType::General, "d"));
+    ASSERT_TEST(manager.countAbove(49) == 3);
+    ASSERT_TEST(manager.countAbove(90) == 0);
+    ASSERT_TEST(manager.kthHighest(1) == 90);
+    ASSERT_TEST(manager.kthHighest(4) == 10);
+
+    manager.bumpPriorityByType(TaskType::Testing, 45);
+    ASSERT_TEST(manager.countAbove(90) == 2);
+    ASSERT_TEST(manager.kthHighest(1) == 100);
+    ASSERT_TEST(manager.kthHighest(2) == 95);
+    ASSERT_TEST(manager.kthHighest(3) == 90);
+
+    std::vector<Task> top = manager.topK(2);
+    ASSERT_TEST(top.size() == 2);
+    ASSERT_TEST(top[0].getId() == 2 && top[0].getPriority() == 100);
+    ASSERT_TEST(top[1].getId() == 0 && top[1].getPriority() == 95);
+    ASSERT_TEST(manager.topK(10).size() == 4);
+    std::vector<Task> testing = manager.topK(5, TaskType::Testing);
+    ASSERT_TEST(testing.size() == 2 && testing[1].getId() == 0);
+
+    manager.completeTask("Hana");
+    ASSERT_TEST(manager.kthHighest(1) == 95);
+    ASSERT_TEST(manager.countAbove(0) == 3);
+    try
+    {
+        manager.kthHighest(4);
+        return false;
+    }
+    catch (const std::out_of_range &)
+    {
+    }
+    return true;
+}
+
+bool testTaskManagerTaskIndex()
+{
+    SortedList<int, mtm::SkipListBackend> list;
+    for (int i = 0; i < 100; i++)
+    {
+        list.insert(i);
+    }
+    ASSERT_TEST(*list.find(42) == 42);
+    ASSERT_TEST(!(list.find(100) != list.end()));
+    list.modify(list.find(42), [](int &value) { value = 1000; });
+    ASSERT_TEST(list.front() == 1000 && list.length() == 100);
+    ASSERT_TEST(!(list.find(42) != list.end()));
+
+    TaskManager manager;
+    manager.assignTask("Ivy", Task(30, TaskType::Testing, "first"));
+    manager.assignTask("Ivy", Task(30, TaskType::Testing, "second"));
+    manager.assignTask("Jon", Task(80, TaskType::Meeting, "sync"));
+    manager.assignTask("Ivy", Task(60, TaskType::Research, "third"));
+    ASSERT_TEST(manager.findTask(1) != nullptr);
+    ASSERT_TEST(manager.findTask(1)->getDescription() == "second");
+    ASSERT_TEST(manager.findTask(4) == nullptr);
+    ASSERT_TEST(manager.findTask(-1) == nullptr);
+
+    // the index must follow the lazily applied bumps
+    manager.bumpPriorityByType(TaskType::Testing, 50);
+    ASSERT_TEST(manager.findTask(0)->getPriority() == 80);
+    manager.updatePriority(1, 95);
+    ASSERT_TEST(manager.findTask(1)->getPriority() == 95);
+    ASSERT_TEST(manager.kthHighest(1) == 95);
+    manager.bumpPriorityByType(TaskType::Testing, 10);
+    ASSERT_TEST(manager.findTask(1)->getPriority() == 100);
+    ASSERT_TEST(manager.findTask(0)->getPriority() == 90);
+
+    manager.cancelTask(2);
+    ASSERT_TEST(manager.findTask(2) == nullptr);
+    ASSERT_TEST(manager.countAbove(0) == 3);
+    manager.completeTask("Ivy");
+    ASSERT_TEST(manager.findTask(1) == nullptr);
+    manager.printAllTasks();
+    try
+    {
+        manager.cancelTask(1);
+        return false;
+    }
+    catch (const std::invalid_argument &)
+    {
+    }
+    try
+    {
+        manager.updatePriority(7, 10);
+        return false;
+    }
+    catch (const std::invalid_argument &)
+    {
+    }
+
+    // completed tasks are dropped from the index, and lookups still work after it is trimmed
+    TaskManager churned;
+    for (int i = 0; i < 500; i++)
+    {
+        churned.assignTask("Kim", Task(50, TaskType::General));
+        churned.completeTask("Kim");
+    }
+    int kept = churned.assignTask("Kim", Task(50, TaskType::General));
+    ASSERT_TEST(churned.findTask(0) == nullptr && churned.findTask(499) == nullptr);
+    ASSERT_TEST(churned.findTask(kept) != nullptr && churned.findTask(kept + 1) == nullptr);
+    churned.cancelTask(kept);
+    ASSERT_TEST(churned.findTask(churned.assignTask("Kim", Task(10, TaskType::General))) != nullptr);
+    return true;
+}
+
+bool testCompactTask()
+{
+    ASSERT_TEST(sizeof(Task) <= 24);
+    std::string text = "shared description";
+    Task first(10, TaskType::Meeting, text);
+    Task second(20, TaskType::Testing, "shared description");
+    ASSERT_TEST(first.getDescription() == "shared description");
+    ASSERT_TEST(first.getDescription().data() == second.getDescription().data());
+    text = "changed";
+    ASSERT_TEST(first.getDescription() == "shared description");
+    Task empty(5, TaskType::General);
+    ASSERT_TEST(empty.getDescription().empty());
+    Task clamped(300, TaskType::General);
+    ASSERT_TEST(clamped.getPriority() == 100);
+
+    // a description is freed with the last task referring to it, once the thread's cache lets go
+    size_t pooled = mtm::StringPool::global().size();
+    std::thread([]() {
+        for (int i = 0; i < 1000; i++)
+        {
+            Task unique(1, TaskType::General, "unique " + std::to_string(i));
+        }
+    }).join();
+    ASSERT_TEST(mtm::StringPool::global().size() == pooled);
+    return true;
+}
+
+bool testTaskManagerColumnScans()
+{
+    TaskManager manager;
+    const int count = 500;
+    for (int i = 0; i < count; i++)
+    {
+        manager.assignTask(i % 2 ? "Kim" : "Lee", Task(i % 101, static_cast<TaskType>(i % TASK_TYPE_COUNT)));
+    }
+    // cancel two thirds of the tasks, enough to make the store drop its dead rows
+    for (int i = 0; i < count; i++)
+    {
+        if (i % 3 != 2)
+        {
+            manager.cancelTask(i);
+        }
+    }
+    manager.bumpPriorityByType(TaskType::Testing, 30);
+    manager.updatePriority(2, 100);
+
+    std::vector<int> testing = manager.findTaskIds(TaskType::Testing);
+    std::vector<int> high = manager.findTaskIds(90, 100);
+    size_t expectedTesting = 0;
+    size_t expectedHigh = 0;
+    int previous = -1;
+    for (int id : testing)
+    {
+        ASSERT_TEST(id > previous && manager.findTask(id)->getType() == TaskType::Testing);
+        previous = id;
+    }
+    for (int id : high)
+    {
+        ASSERT_TEST(manager.findTask(id)->getPriority() >= 90);
+    }
+    for (int i = 0; i < count; i++)
+    {
+        const Task *task = manager.findTask(i);
+        ASSERT_TEST((task == nullptr) == (i % 3 != 2));
+        if (task != nullptr)
+        {
+            ASSERT_TEST(task->getId() == i);
+            expectedTesting += task->getType() == TaskType::Testing;
+            expectedHigh += task->getPriority() >= 90;
+        }
+    }
+    ASSERT_TEST(testing.size() == expectedTesting);
+    ASSERT_TEST(high.size() == expectedHigh);
+    ASSERT_TEST(static_cast<int>(high.size()) == manager.countAbove(89));
+    ASSERT_TEST(manager.findTaskIds(50, 40).empty());
+
+    // rows added or updated between bumps receive only the bumps issued after them
+    TaskManager mixed;
+    for (int i = 0; i < 100; i++)
+    {
+        mixed.assignTask("Kim", Task(10, TaskType::Research));
+    }
+    mixed.bumpPriorityByType(TaskType::Research, 20);
+    for (int i = 0; i < 40; i++)
+    {
+        mixed.assignTask("Lee", Task(10, TaskType::Research));
+    }
+    mixed.updatePriority(7, 5);
+    mixed.bumpPriorityByType(TaskType::Research, 5);
+    ASSERT_TEST(mixed.findTask(0)->getPriority() == 35 && mixed.findTask(100)->getPriority() == 15);
+    ASSERT_TEST(mixed.findTaskIds(35, 35).size() == 99 && mixed.findTaskIds(15, 15).size() == 40);
+    ASSERT_TEST(mixed.findTaskIds(10, 10) == std::vector<int>{7});
+    return true;
+}
+
+bool testTaskWriter()
+{
+    Person person("Max");
+    Task first(7, TaskType::CustomerSupport, "call back");
+    first.setId(12);
+    Task second(100, TaskType::Meeting);
+    second.setId(3);
+    person.assignTask(first);
+    person.assignTask(second);
+    std::ostringstream expected;
+    expected << person << first << -42;
+
+    std::string text;
+    StringSink sink(text);
+    TaskWriter writer(sink);
+    writer.writePerson(person);
+    writer.writeTask(first);
+    writer.write(-42);
+    ASSERT_TEST(text.empty());
+    writer.flush();
+    ASSERT_TEST(text == expected.str());
+
+    TaskManager manager;
+    manager.assignTask("Max", Task(5, TaskType::Testing, "check"));
+    manager.assignTask("Noa", Task(9, TaskType::Testing, "verify"));
+    std::string tasks;
+    StringSink tasksSink(tasks);
+    manager.printTasksByType(TaskType::Testing, tasksSink);
+    ASSERT_TEST(tasks == "Task ID: 1, Priority: 9, Type: Testing, Description: verify\n"
+                         "Task ID: 0, Priority: 5, Type: Testing, Description: check\n");
+    manager.printAllEmployees();
+    return true;
+}
+
+bool testTaskManagerRanges()
+{
+    TaskManager manager;
+    manager.assignTask("Oren", Task(20, TaskType::Research, "read"));
+    manager.assignTask("Pia", Task(80, TaskType::Testing, "run"));
+    manager.assignTask("Oren", Task(50, TaskType::Testing, "write"));
+    manager.bumpPriorityByType(TaskType::Research, 70);
+
+    int expected[] = {0, 1, 2};
+    int i = 0;
+    for (const Task &task : manager.tasks())
+    {
+        ASSERT_TEST(i < 3 && task.getId() == expected[i++]);
+    }
+    ASSERT_TEST(i == 3);
+
+    const Task *first = nullptr;
+    for (const Task &task : manager.tasksByType(TaskType::Testing))
+    {
+        first = first ? first : &task;
+    }
+    ASSERT_TEST(first != nullptr && first == manager.findTask(1));
+
+    int visited = 0;
+    manager.visitTasksByType(TaskType::Research, [&visited](const Task &task) {
+        visited += task.getPriority();
+    });
+    ASSERT_TEST(visited == 90);
+
+    std::string names;
+    for (const Person &person : manager.employees())
+    {
+        names += person.getName();
+    }
+    ASSERT_TEST(names == "OrenPia");
+    int tasks = 0;
+    manager.visitEmployees([&tasks](const Person &person) {
+        tasks += person.getTasks().length();
+    });
+    ASSERT_TEST(tasks == 3);
+    return true;
+}
+
+bool testConcurrentTaskManager()
+{
+    ConcurrentTaskManager manager(4);
+    std::vector<std::thread> threads;
+    std::vector<std::vector<int>> ids(4);
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&manager, &mine = ids[t], t]() {
+            PersonHandle person = manager.getPersonHandle("Worker" + std::to_string(t));
+            for (int i = 0; i < 100; i++)
+            {
+                mine.push_back(manager.assignTask(person, Task(i, TaskType::Development)));
+            }
+            for (int i = 0; i < 50; i++)
+            {
+                manager.completeTask(person);
+            }
+        });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    std::vector<int> all;
+    for (const std::vector<int> &mine : ids)
+    {
+        all.insert(all.end(), mine.begin(), mine.end());
+    }
+    std::sort(all.begin(), all.end());
+    ASSERT_TEST(std::adjacent_find(all.begin(), all.end()) == all.end());
+
+    // every worker completed its 50 highest tasks, priorities 50 to 99
+    ASSERT_TEST(manager.countAbove(-1) == 200);
+    ASSERT_TEST(manager.countAbove(49) == 0);
+    ASSERT_TEST(manager.kthHighest(1) == 49);
+    ASSERT_TEST(manager.kthHighest(200) == 0);
+    ASSERT_TEST(manager.findTask(ids[2][10]).has_value());
+    ASSERT_TEST(!manager.findTask(ids[2][99]).has_value());
+
+    manager.updatePriority(ids[1][0], 100);
+    ASSERT_TEST(manager.kthHighest(1) == 100);
+    manager.cancelTask(ids[1][0]);
+    ASSERT_TEST(manager.countAbove(-1) == 199);
+
+    std::string text;
+    StringSink sink(text);
+    manager.printAllTasks(sink);
+    int first = std::min({ids[0][49], ids[1][49], ids[2][49], ids[3][49]});
+    ASSERT_TEST(text.rfind("Task ID: " + std::to_string(first) + ", Priority: 49,", 0) == 0);
+    ASSERT_TEST(std::count(text.begin(), text.end(), '\n') == 199);
+    return true;
+}
+
+bool testTaskIntake()
+{
+    TaskManager manager;
+    std::vector<std::vector<std::future<int>>> ids(4);
+    std::atomic<int> callbacks(0);
+    {
+        TaskIntake intake(manager, 16, 4);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++)
+        {
+            threads.emplace_back([&intake, &mine = ids[t], &callbacks, t]() {
+                std::string name = "Producer" + std::to_string(t);
+                for (int i = 0; i < 50; i++)
+                {
+                    mine.push_back(intake.assignTask(name, Task(i, TaskType::Testing)));
+                    intake.assignTask(name, Task(0, TaskType::General), [&callbacks](int id, std::exception_ptr error) {
+                        callbacks += id >= 0 && !error ? 1 : 0;
+                    });
+                }
+            });
+        }
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+        intake.flush();
+        ASSERT_TEST(callbacks == 200);
+        ASSERT_TEST(manager.countAbove(-1) == 400);
+
+        std::exception_ptr failure;
+        intake.assignTask("Solo", Task(10, TaskType::General));
+        intake.completeTask("Solo");
+        intake.completeTask("Solo", [&failure](int, std::exception_ptr error) {
+            failure = error;
+        });
+        intake.bumpPriorityByType(TaskType::Testing, 100);
+        intake.flush();
+        ASSERT_TEST(failure != nullptr);
+        ASSERT_TEST(manager.countAbove(99) == 200);
+
+        // a throwing callback is counted and the applier carries on with the next command
+        intake.bumpPriorityByType(TaskType::Testing, 0, [](int, std::exception_ptr) {
+            throw std::runtime_error("callback failed");
+        });
+        ASSERT_TEST(intake.assignTask("Solo", Task(5, TaskType::General)).get() >= 0);
+        ASSERT_TEST(intake.callbackFailures() == 1);
+        intake.completeTask("Solo");
+
+        // not flushed, the destructor applies it
+        intake.assignTask("Solo", Task(100, TaskType::Research));
+    }
+    ASSERT_TEST(manager.countAbove(-1) == 401);
+
+    std::vector<int> all;
+    for (std::vector<std::future<int>> &mine : ids)
+    {
+        for (std::future<int> &id : mine)
+        {
+            all.push_back(id.get());
+        }
+    }
+    std::sort(all.begin(), all.end());
+    ASSERT_TEST(std::adjacent_find(all.begin(), all.end()) == all.end());
+    return true;
+}
+
+bool testTaskExecutor()
+{
+    Person person("Queue");
+    Task low(10, TaskType::Research);
+    low.setId(2);
+    Task tied(10, TaskType::General);
+    tied.setId(1);
+    person.assignTask(low);
+    person.assignTask(tied);
+    person.assignTask(Task(90, TaskType::Testing));
+    ASSERT_TEST(person.getLowestPriorityTask().getId() == 2);
+    ASSERT_TEST(person.removeLowestPriorityTask() == 2 && person.removeLowestPriorityTask() == 1);
+    ASSERT_TEST(person.getLowestPriorityTask().getPriority() == 90);
+
+    {
+        TaskExecutor executor(1);
+        std::promise<void> gate;
+        std::shared_future<void> opened = gate.get_future().share();
+        std::vector<int> order;
+        executor.submit(Task(100, TaskType::General), [opened]() { opened.wait(); });
+        int priorities[] = {10, 50, 30, 50};
+        for (int priority : priorities)
+        {
+            executor.submit(Task(priority, TaskType::General), [&order, priority]() { order.push_back(priority); });
+        }
+        executor.submit(Task(20, TaskType::General), [&order]() {
+            order.push_back(20);
+            throw std::runtime_error("failed");
+        });
+        gate.set_value();
+        executor.wait();
+
+        std::vector<int> expected = {50, 50, 30, 20, 10};
+        ASSERT_TEST(order == expected);
+        ExecutorStats stats = executor.stats();
+        ASSERT_TEST(stats.executed == 6 && stats.failed == 1 && stats.stolen == 0);
+        ASSERT_TEST(stats.countByPriority[50] == 2 && stats.countByPriority[100] == 1);
+    }
+
+    std::atomic<int> done(0);
+    TaskExecutor executor(4);
+    for (int i = 0; i < 200; i++)
+    {
+        executor.submit(0, Task(i % 101, TaskType::Development), [&done]() { done++; });
+    }
+    executor.wait();
+    ASSERT_TEST(done == 200);
+    ExecutorStats stats = executor.stats();
+    ASSERT_TEST(stats.executed == 200 && stats.stolen <= 200);
+    return true;
+}
+
+bool testParallelBulkOperations()
+{
+    TaskManager serial;
+    TaskManager parallel;
+    parallel.setParallelism(4);
+    TaskManager *managers[] = {&serial, &parallel};
+    for (TaskManager *manager : managers)
+    {
+        unsigned int seed = 7;
+        for (int i = 0; i < 20000; i++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            std::string name = "Person" + std::to_string(seed % 97);
+            manager->assignTask(name, Task(static_cast<int>(seed >> 8) % 101, static_cast<TaskType>((seed >> 4) % TASK_TYPE_COUNT)));
+            if (i % 500 == 0)
+            {
+                manager->bumpPriorityByType(static_cast<TaskType>(i % TASK_TYPE_COUNT), 7);
+            }
+        }
+        manager->bumpPriorityByType(TaskType::Testing, 30);
+        manager->completeTask("Person3");
+    }
+
+    std::string expected[3];
+    std::string actual[3];
+    for (int round = 0; round < 2; round++)
+    {
+        std::string *out = round == 0 ? expected : actual;
+        StringSink employees(out[0]);
+        StringSink all(out[1]);
+        StringSink ofType(out[2]);
+        managers[round]->printAllEmployees(employees);
+        managers[round]->printAllTasks(all);
+        managers[round]->printTasksByType(TaskType::Testing, ofType);
+    }
+    for (int i = 0; i < 3; i++)
+    {
+        ASSERT_TEST(!expected[i].empty() && expected[i] == actual[i]);
+    }
+
+    // a sink that fails part way stops the print, and the manager can still print afterwards
+    struct FailingSink : OutputSink
+    {
+        int writes = 0;
+        void write(const char *, size_t) override
+        {
+            if (++writes == 3)
+            {
+                throw std::runtime_error("sink failed");
+            }
+        }
+    };
+    FailingSink failing;
+    try
+    {
+        parallel.printAllTasks(failing);
+        return false;
+    }
+    catch (const std::runtime_error &)
+    {
+    }
+    std::string again;
+    StringSink againSink(again);
+    parallel.printAllTasks(againSink);
+    ASSERT_TEST(again == expected[1]);
+
+    TaskManager empty;
+    empty.setParallelism(2);
+    std::string nothing;
+    StringSink sink(nothing);
+    empty.printAllTasks(sink);
+    empty.printAllEmployees(sink);
+    ASSERT_TEST(nothing.empty());
+    return true;
+}
+
+bool testTaskManagerSnapshot()
+{
+    TaskManager original;
+    original.assignTask("Rina", Task(40, TaskType::Development, "build"));
+    original.assignTask("Saar", Task(70, TaskType::Testing, "verify"));
+    original.assignTask("Rina", Task(40, TaskType::Testing, "verify"));
+    original.assignTask("Tal", Task(10, TaskType::General));
+    original.assignTask("Saar", Task(90, TaskType::Meeting, "sync"));
+    original.completeTask("Tal");
+    original.cancelTask(1);
+    original.bumpPriorityByType(TaskType::Testing, 25);
+    bool unwritable = false;
+    try
+    {
+        original.saveSnapshot("no_such_directory/snapshot_test.bin");
+    }
+    catch (const std::runtime_error &)
+    {
+        unwritable = true;
+    }
+    ASSERT_TEST(unwritable);
+    original.saveSnapshot("snapshot_test.bin");
+
+    TaskManager loaded;
+    loaded.assignTask("Stale", Task(5, TaskType::General));
+    loaded.loadSnapshot("snapshot_test.bin");
+
+    std::string before[2];
+    std::string after[2];
+    StringSink beforeEmployees(before[0]);
+    StringSink beforeTasks(before[1]);
+    StringSink afterEmployees(after[0]);
+    StringSink afterTasks(after[1]);
+    original.printAllEmployees(beforeEmployees);
+    original.printAllTasks(beforeTasks);
+    loaded.printAllEmployees(afterEmployees);
+    loaded.printAllTasks(afterTasks);
+    ASSERT_TEST(before[0] == after[0] && before[1] == after[1]);
+    ASSERT_TEST(loaded.findTask(2) != nullptr && loaded.findTask(2)->getPriority() == 65);
+    ASSERT_TEST(loaded.findTask(1) == nullptr && loaded.countAbove(-1) == 3);
+    ASSERT_TEST(loaded.assignTask("Tal", Task(1, TaskType::General)) == original.assignTask("Tal", Task(1, TaskType::General)));
+
+    // a flipped byte fails the checksum and leaves the manager as it was
+    std::string bytes;
+    {
+        std::ifstream in("snapshot_test.bin", std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    bytes[bytes.size() - 2] ^= 1;
+    {
+        std::ofstream out("snapshot_test.bin", std::ios::binary | std::ios::trunc);
+        out << bytes;
+    }
+    bool rejected = false;
+    try
+    {
+        loaded.loadSnapshot("snapshot_test.bin");
+    }
+    catch (const std::runtime_error &)
+    {
+        rejected = true;
+    }
+    std::remove("snapshot_test.bin");
+    ASSERT_TEST(rejected && loaded.countAbove(-1) == 4);
+
+    // the loaded tasks are reached through the handles set while loading
+    loaded.updatePriority(2, 5);
+    ASSERT_TEST(loaded.findTask(2)->getId() == 2 && loaded.findTask(2)->getPriority() == 5);
+    loaded.cancelTask(2);
+    ASSERT_TEST(loaded.findTask(2) == nullptr && loaded.countAbove(-1) == 3);
+
+    // the same high bit flipped in two different words still changes the checksum
+    char words[64] = {};
+    uint64_t clean = snapshotChecksum(words, sizeof(words));
+    words[7] ^= static_cast<char>(0x80);
+    words[15] ^= static_cast<char>(0x80);
+    ASSERT_TEST(snapshotChecksum(words, sizeof(words)) != clean);
+    words[15] ^= static_cast<char>(0x80);
+    words[47] ^= static_cast<char>(0x80);
+    ASSERT_TEST(snapshotChecksum(words, sizeof(words)) != clean);
+
+    // the records come from the live tasks only, however many were cancelled before them
+    TaskManager churned;
+    for (int i = 0; i < 5000; i++)
+    {
+        churned.cancelTask(churned.assignTask("Rina", Task(i % 101, TaskType::General, "gone")));
+    }
+    int kept = churned.assignTask("Saar", Task(30, TaskType::Documentation, "kept"));
+    churned.saveSnapshot("snapshot_test.bin");
+    TaskManager reloaded;
+    reloaded.loadSnapshot("snapshot_test.bin");
+    std::remove("snapshot_test.bin");
+    ASSERT_TEST(reloaded.countAbove(-1) == 1 && reloaded.findTask(kept) != nullptr);
+    ASSERT_TEST(reloaded.findTask(kept)->getDescription() == "kept");
+    ASSERT_TEST(reloaded.assignTask("Tal", Task(1, TaskType::General)) == kept + 1);
+    return true;
+}
+
+bool testTaskManagerJournal()
+{
+    std::remove("journal_test.snap");
+    std::remove("journal_test.log");
+    std::string expected[2];
+    {
+        TaskManager original;
+        original.recover("journal_test.snap", "journal_test.log", 2);
+        original.assignTask("Rina", Task(40, TaskType::Development, "build"));
+        original.assignTask("Saar", Task(70, TaskType::Testing, "verify"));
+        original.assignTask("Rina", Task(20, TaskType::Testing, "verify"));
+        original.bumpPriorityByType(TaskType::Testing, 15);
+        original.saveSnapshot("journal_test.snap");
+        // only the changes after the snapshot are left to replay
+        original.assignTask("Tal", Task(10, TaskType::General));
+        original.completeTask("Saar");
+        original.updatePriority(0, 95);
+        original.cancelTask(2);
+        original.assignTask("Saar", Task(50, TaskType::Meeting, "sync"));
+        // a change that throws is not logged and uses up no ID
+        bool thrown = false;
+        try
+        {
+            original.assignTask(PersonHandle(99), Task(1, TaskType::General));
+        }
+        catch (const std::invalid_argument &)
+        {
+            thrown = true;
+        }
+        ASSERT_TEST(thrown);
+        original.syncJournal();
+        StringSink employees(expected[0]);
+        StringSink tasks(expected[1]);
+        original.printAllEmployees(employees);
+        original.printAllTasks(tasks);
+    }
+
+    std::string recovered[2];
+    {
+        TaskManager restored;
+        restored.recover("journal_test.snap", "journal_test.log");
+        StringSink employees(recovered[0]);
+        StringSink tasks(recovered[1]);
+        restored.printAllEmployees(employees);
+        restored.printAllTasks(tasks);
+        ASSERT_TEST(restored.assignTask("Tal", Task(1, TaskType::General)) == 5);
+    }
+    ASSERT_TEST(expected[0] == recovered[0] && expected[1] == recovered[1]);
+
+    // a torn block at the end is dropped, and the change after it is kept
+    {
+        std::ofstream out("journal_test.log", std::ios::binary | std::ios::app);
+        out << "a block torn halfway through";
+    }
+    std::string repaired[2];
+    {
+        TaskManager restored;
+        restored.recover("journal_test.snap", "journal_test.log");
+        StringSink employees(repaired[0]);
+        StringSink tasks(repaired[1]);
+        restored.printAllEmployees(employees);
+        restored.printAllTasks(tasks);
+        ASSERT_TEST(restored.findTask(5) != nullptr && restored.countAbove(-1) == 4);
+    }
+    std::remove("journal_test.snap");
+    std::remove("journal_test.log");
+    ASSERT_TEST(repaired[0].find("Task ID: 5") != std::string::npos);
+
+    // a group that never fills is still committed once its oldest change has waited long enough
+    {
+        TaskManager timed;
+        timed.openJournal("journal_test.log", 1000, 5);
+        timed.assignTask("Rina", Task(40, TaskType::Development, "build"));
+        timed.assignTask("Saar", Task(70, TaskType::Testing, "verify"));
+        int replayed = 0;
+        for (int attempt = 0; attempt < 200 && replayed < 4; attempt++)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            replayed = 0;
+            TaskJournal::replay("journal_test.log", 0, [&replayed](const TaskJournal::Record &) { replayed++; });
+        }
+        ASSERT_TEST(replayed == 4);
+    }
+
+    // without a snapshot the journal is replayed onto an empty manager, whatever it held before
+    {
+        TaskManager stale;
+        stale.assignTask("Tal", Task(10, TaskType::General));
+        stale.saveSnapshot("journal_test.snap");
+        std::remove("journal_test.snap");
+        stale.recover("journal_test.snap", "journal_test.log");
+        ASSERT_TEST(stale.countAbove(-1) == 2 && stale.findTask(0)->getDescription() == "build");
+        ASSERT_TEST(stale.findTask(1)->getPriority() == 70 && stale.findTask(2) == nullptr);
+    }
+    std::remove("journal_test.log");
+    return true;
+}
+
+
 // end of tests
 
 
@@ -472,7 +1822,31 @@ bool testTaskManagerAssignTask()
     X(testTaskManager)                       \
     X(testCopyConstructorExceptionSafety)    \
     X(testTaskManagerAssignTask)             \
-    X(testTaskManagerPrintTasksByType)
+    X(testTaskManagerPrintTasksByType)       \
+    X(testSkipList)                      \
+    X(testListMoveAndEmplace)            \
+    X(testListFrontAndRemove)            \
+    X(testListMergeAndSplit)             \
+    X(testListViews)                     \
+    X(testFlatSortedList)                \
+    X(testTaskBucketQueue)               \
+    X(testTaskManagerManyPersons)        \
+    X(testTaskManagerHandles)            \
+    X(testPersonBumpByType)              \
+    X(testTaskManagerLazyBump)           \
+    X(testMergeIterator)                 \
+    X(testTaskManagerRankQueries)        \
+    X(testTaskManagerTaskIndex)          \
+    X(testCompactTask)                   \
+    X(testTaskManagerColumnScans)        \
+    X(testTaskWriter)                    \
+    X(testTaskManagerRanges)             \
+    X(testConcurrentTaskManager)         \
+    X(testTaskIntake)                    \
+    X(testTaskExecutor)                  \
+    X(testParallelBulkOperations)        \
+    X(testTaskManagerSnapshot)           \
+    X(testTaskManagerJournal)
 
 
 testFunc tests[] = {